@@ -939,6 +939,13 @@ extern "C" {
  */
 #define GLFW_POSITION_Y             0x0002000F
 
+/*! @brief Asynchronous presentation window hint and attribute
+ *
+ *  Asynchronous presentation [window hint](@ref GLFW_ASYNC_PRESENTATION_hint)
+ *  or [window attribute](@ref GLFW_ASYNC_PRESENTATION_attrib).
+ */
+#define GLFW_ASYNC_PRESENTATION     0x00020010
+
 /*! @brief Framebuffer bit depth hint.
  *
  *  Framebuffer bit depth [hint](@ref GLFW_RED_BITS).
@@ -1142,6 +1149,7 @@ extern "C" {
 #define GLFW_STICKY_MOUSE_BUTTONS   0x00033003
 #define GLFW_LOCK_KEY_MODS          0x00033004
 #define GLFW_RAW_MOUSE_MOTION       0x00033005
+#define GLFW_KEY_REPEAT_LIMIT       0x00033006
 
 #define GLFW_CURSOR_NORMAL          0x00034001
 #define GLFW_CURSOR_HIDDEN          0x00034002
@@ -1278,6 +1286,25 @@ extern "C" {
 #define GLFW_CONNECTED              0x00040001
 #define GLFW_DISCONNECTED           0x00040002
 
+/*! @addtogroup input
+ *  @{ */
+/*! @brief Joystick axis sample type.
+ *
+ *  Joystick axis [sample type](@ref joystick_samples).
+ */
+#define GLFW_JOYSTICK_AXIS_SAMPLE   0x00040003
+/*! @brief Joystick button sample type.
+ *
+ *  Joystick button [sample type](@ref joystick_samples).
+ */
+#define GLFW_JOYSTICK_BUTTON_SAMPLE 0x00040004
+/*! @brief Joystick hat sample type.
+ *
+ *  Joystick hat [sample type](@ref joystick_samples).
+ */
+#define GLFW_JOYSTICK_HAT_SAMPLE    0x00040005
+/*! @} */
+
 /*! @addtogroup init
  *  @{ */
 /*! @brief Joystick hat buttons init hint.
@@ -1295,6 +1322,16 @@ extern "C" {
  *  Platform selection [init hint](@ref GLFW_PLATFORM).
  */
 #define GLFW_PLATFORM               0x00050003
+/*! @brief Joystick sample history init hint.
+ *
+ *  Joystick sample history [init hint](@ref GLFW_JOYSTICK_SAMPLE_HISTORY).
+ */
+#define GLFW_JOYSTICK_SAMPLE_HISTORY 0x00050004
+/*! @brief Joystick reader thread init hint.
+ *
+ *  Joystick reader thread [init hint](@ref GLFW_JOYSTICK_THREAD).
+ */
+#define GLFW_JOYSTICK_THREAD        0x00050005
 /*! @brief macOS specific init hint.
  *
  *  macOS specific [init hint](@ref GLFW_COCOA_CHDIR_RESOURCES_hint).
@@ -1310,6 +1347,11 @@ extern "C" {
  *  X11 specific [init hint](@ref GLFW_X11_XCB_VULKAN_SURFACE_hint).
  */
 #define GLFW_X11_XCB_VULKAN_SURFACE 0x00052001
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_SELECTION_CHUNK_SIZE_hint).
+ */
+#define GLFW_X11_SELECTION_CHUNK_SIZE 0x00052002
 /*! @brief Wayland specific init hint.
  *
  *  Wayland specific [init hint](@ref GLFW_WAYLAND_LIBDECOR_hint).
@@ -1741,6 +1783,31 @@ typedef void (* GLFWframebuffersizefun)(GLFWwindow* window, int width, int heigh
  */
 typedef void (* GLFWwindowcontentscalefun)(GLFWwindow* window, float xscale, float yscale);
 
+/*! @brief The function pointer type for window presentation callbacks.
+ *
+ *  This is the function pointer type for window presentation callbacks.
+ *  A window presentation callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, double time, double refresh, uint64_t sequence)
+ *  @endcode
+ *
+ *  @param[in] window The window whose frame was presented.
+ *  @param[in] time The time, in seconds, when the frame was shown on the
+ *  display, in the same time base as @ref glfwGetTime.
+ *  @param[in] refresh The refresh interval of the display, in seconds, or zero
+ *  if unknown.
+ *  @param[in] sequence The vertical retrace counter of the display when the
+ *  frame was shown, or zero if unknown.
+ *
+ *  @sa @ref window_present
+ *  @sa @ref glfwSetWindowPresentCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWwindowpresentfun)(GLFWwindow* window, double time, double refresh, uint64_t sequence);
+
 /*! @brief The function pointer type for mouse button callbacks.
  *
  *  This is the function pointer type for mouse button callback functions.
@@ -1972,6 +2039,73 @@ typedef void (* GLFWmonitorfun)(GLFWmonitor* monitor, int event);
  */
 typedef void (* GLFWjoystickfun)(int jid, int event);
 
+/*! @brief The function pointer type for joystick axis callbacks.
+ *
+ *  This is the function pointer type for joystick axis callbacks.  A joystick
+ *  axis callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int axis, float value)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose axis changed.
+ *  @param[in] axis The index of the axis, as used by @ref glfwGetJoystickAxes.
+ *  @param[in] value The new value of the axis, from -1.0 to 1.0.
+ *
+ *  @sa @ref joystick_axis
+ *  @sa @ref glfwSetJoystickAxisCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickaxisfun)(int jid, int axis, float value);
+
+/*! @brief The function pointer type for joystick button callbacks.
+ *
+ *  This is the function pointer type for joystick button callbacks.
+ *  A joystick button callback function has the following signature:
+ *  @code
+ *  void function_name(int jid, int button, int action)
+ *  @endcode
+ *
+ *  @param[in] jid The joystick whose button changed.
+ *  @param[in] button The index of the button, as used by @ref
+ *  glfwGetJoystickButtons.
+ *  @param[in] action One of `GLFW_PRESS` or `GLFW_RELEASE`.
+ *
+ *  @sa @ref joystick_button
+ *  @sa @ref glfwSetJoystickButtonCallback
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWjoystickbuttonfun)(int jid, int button, int action);
+
+/*! @brief The function pointer type for clipboard string callbacks.
+ *
+ *  This is the function pointer type for clipboard string callbacks, used to
+ *  complete an asynchronous clipboard request.  A clipboard string callback
+ *  function has the following signature:
+ *  @code
+ *  void function_name(const char* string)
+ *  @endcode
+ *
+ *  @param[in] string The contents of the clipboard as a UTF-8 encoded string,
+ *  or `NULL` if the clipboard was empty, its contents could not be converted or
+ *  the request timed out.
+ *
+ *  @pointer_lifetime The string is valid until the callback function returns.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwRequestClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWclipboardfun)(const char* string);
+
 /*! @brief Video mode type.
  *
  *  This describes a single video mode.
@@ -2084,6 +2218,39 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Joystick input sample.
+ *
+ *  This describes a single change of a joystick axis, button or hat.
+ *
+ *  @sa @ref joystick_samples
+ *  @sa @ref glfwGetJoystickSamples
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWjoysticksample
+{
+    /*! The time of the change, in the same time base as @ref glfwGetTime.
+     */
+    double time;
+    /*! One of `GLFW_JOYSTICK_AXIS_SAMPLE`, `GLFW_JOYSTICK_BUTTON_SAMPLE` or
+     *  `GLFW_JOYSTICK_HAT_SAMPLE`.
+     */
+    int type;
+    /*! The index of the axis, button or hat that changed.
+     */
+    int index;
+    /*! The new value of the axis, in the range -1.0 to 1.0 inclusive.  This is
+     *  zero for buttons and hats.
+     */
+    float value;
+    /*! The new state of the button, `GLFW_PRESS` or `GLFW_RELEASE`, or the new
+     *  [state of the hat](@ref joystick_hat).  This is zero for axes.
+     */
+    int state;
+} GLFWjoysticksample;
+
 /*! @brief
  *
  *  @sa @ref init_allocator
@@ -4026,6 +4193,7 @@ GLFWAPI int glfwGetWindowAttrib(GLFWwindow* window, int attrib);
  *  [GLFW_AUTO_ICONIFY](@ref GLFW_AUTO_ICONIFY_attrib) and
  *  [GLFW_FOCUS_ON_SHOW](@ref GLFW_FOCUS_ON_SHOW_attrib).
  *  [GLFW_MOUSE_PASSTHROUGH](@ref GLFW_MOUSE_PASSTHROUGH_attrib)
+ *  [GLFW_ASYNC_PRESENTATION](@ref GLFW_ASYNC_PRESENTATION_attrib)
  *
  *  Some of these attributes are ignored for full screen windows.  The new
  *  value will take effect if the window is later made windowed.
@@ -4398,6 +4566,88 @@ GLFWAPI GLFWframebuffersizefun glfwSetFramebufferSizeCallback(GLFWwindow* window
  */
 GLFWAPI GLFWwindowcontentscalefun glfwSetWindowContentScaleCallback(GLFWwindow* window, GLFWwindowcontentscalefun callback);
 
+/*! @brief Sets the presentation callback for the specified window.
+ *
+ *  This function sets the presentation callback of the specified window, which
+ *  is called when a frame swapped with @ref glfwSwapBuffers has been shown on
+ *  the display.  The callback receives the time of presentation as reported
+ *  by the window system, which can be used to measure display latency and to
+ *  pace rendering.
+ *
+ *  Presentation feedback is only requested for frames swapped while the
+ *  callback is set.  Frames that were replaced before being shown do not
+ *  cause the callback to be called.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(GLFWwindow* window, double time, double refresh, uint64_t sequence)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWwindowpresentfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @wayland Presentation feedback requires the compositor to support
+ *  the `wp_presentation` protocol and is only available for windows with an
+ *  EGL context.
+ *
+ *  @remark @win32 @macos @x11 @null Presentation feedback is not yet
+ *  implemented and the callback is never called.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref window_present
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI GLFWwindowpresentfun glfwSetWindowPresentCallback(GLFWwindow* window, GLFWwindowpresentfun callback);
+
+/*! @brief Returns whether the window system is ready for a new frame.
+ *
+ *  This function returns whether the window system wants a new frame for the
+ *  specified window.  This lets you render each window exactly when its
+ *  contents can be shown, without blocking in @ref glfwSwapBuffers, for
+ *  example with a swap interval of zero and many windows on one thread.
+ *
+ *  After a buffer swap, the window is not ready until the window system has
+ *  signaled that it wants the next frame.  Event processing functions such as
+ *  @ref glfwWaitEvents return when this happens.  A window that is hidden or
+ *  fully obscured may not become ready until it is shown again.
+ *
+ *  @param[in] window The window to query.
+ *  @return `GLFW_TRUE` if the window is ready for a new frame, or `GLFW_FALSE`
+ *  otherwise or if an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @wayland Readiness is tracked with `wl_surface.frame` callbacks,
+ *  which are requested for swaps made after the first call to this function
+ *  for the window.  This is only available for windows with an EGL context.
+ *  For other windows, including those rendered to with Vulkan, this function
+ *  always returns `GLFW_TRUE`.
+ *
+ *  @remark @win32 @macos @x11 @null The window system provides no readiness
+ *  signal and this function always returns `GLFW_TRUE`.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref buffer_swap
+ *  @sa @ref glfwSwapBuffers
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwWindowReadyForFrame(GLFWwindow* window);
+
 /*! @brief Processes all pending events.
  *
  *  This function processes only those events that are already in the event
@@ -4554,13 +4804,13 @@ GLFWAPI void glfwPostEmptyEvent(void);
  *
  *  This function returns the value of an input option for the specified window.
  *  The mode must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_RAW_MOUSE_MOTION or @ref GLFW_KEY_REPEAT_LIMIT.
  *
  *  @param[in] window The window to query.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`,
+ *  `GLFW_RAW_MOUSE_MOTION` or `GLFW_KEY_REPEAT_LIMIT`.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_INVALID_ENUM.
@@ -4579,8 +4829,8 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *
  *  This function sets an input mode option for the specified window.  The mode
  *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
- *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS or
- *  @ref GLFW_RAW_MOUSE_MOTION.
+ *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS,
+ *  @ref GLFW_RAW_MOUSE_MOTION or @ref GLFW_KEY_REPEAT_LIMIT.
  *
  *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
  *  modes:
@@ -4620,15 +4870,26 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* window, int mode);
  *  attempting to set this will emit @ref GLFW_FEATURE_UNAVAILABLE.  Call @ref
  *  glfwRawMouseMotionSupported to check for support.
  *
+ *  If the mode is `GLFW_KEY_REPEAT_LIMIT`, the value is the maximum number of
+ *  key repeat events reported for a single wakeup, or zero for no limit.  If
+ *  the application has not processed events for a while, any repeats beyond
+ *  the limit are dropped instead of being reported all at once.
+ *
  *  @param[in] window The window whose input mode to set.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
- *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
- *  `GLFW_RAW_MOUSE_MOTION`.
+ *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS`,
+ *  `GLFW_RAW_MOUSE_MOTION` or `GLFW_KEY_REPEAT_LIMIT`.
  *  @param[in] value The new value of the specified input mode.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
- *  GLFW_INVALID_ENUM, @ref GLFW_PLATFORM_ERROR and @ref
- *  GLFW_FEATURE_UNAVAILABLE (see above).
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE, @ref GLFW_PLATFORM_ERROR and
+ *  @ref GLFW_FEATURE_UNAVAILABLE (see above).
+ *
+ *  @remark @wayland `GLFW_KEY_REPEAT_LIMIT` applies to the key repeats that
+ *  GLFW generates itself on this platform.
+ *
+ *  @remark @win32 @macos @x11 `GLFW_KEY_REPEAT_LIMIT` is ignored, as key
+ *  repeats are generated by the window system.
  *
  *  @thread_safety This function must only be called from the main thread.
  *
@@ -5508,6 +5769,50 @@ GLFWAPI const unsigned char* glfwGetJoystickButtons(int jid, int* count);
  */
 GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count);
 
+/*! @brief Retrieves the recorded input samples of the specified joystick.
+ *
+ *  This function moves the oldest recorded input samples of the specified
+ *  joystick into the specified array, in the order they occurred.  Each sample
+ *  describes a single change of an axis, button or hat and when it happened.
+ *  Samples that have been retrieved are removed from the history.
+ *
+ *  Samples are only recorded if the [GLFW_JOYSTICK_SAMPLE_HISTORY](@ref
+ *  GLFW_JOYSTICK_SAMPLE_HISTORY) init hint is set to the number of samples to
+ *  keep per joystick.  If more changes occur than fit in the history before
+ *  they are retrieved, the oldest samples are discarded.
+ *
+ *  Hats are reported only as hat samples, regardless of the
+ *  [GLFW_JOYSTICK_HAT_BUTTONS](@ref GLFW_JOYSTICK_HAT_BUTTONS) init hint.
+ *
+ *  If the specified joystick is not present this function will return zero but
+ *  will not generate an error.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @param[out] samples The array to store the samples in.
+ *  @param[in] count The number of elements in the array.
+ *  @return The number of samples stored in the array, or zero if the joystick
+ *  is not present, no samples are recorded or an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 @wayland Samples are timestamped by the kernel when the device
+ *  reports them.
+ *
+ *  @remark @win32 @macos Samples are timestamped when the joystick state is
+ *  polled, so changes between polls are not recorded.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_samples
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetJoystickSamples(int jid, GLFWjoysticksample* samples, int count);
+
 /*! @brief Returns the name of the specified joystick.
  *
  *  This function returns the name, encoded as UTF-8, of the specified joystick.
@@ -5694,6 +5999,88 @@ GLFWAPI int glfwJoystickIsGamepad(int jid);
  */
 GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun callback);
 
+/*! @brief Sets the joystick axis callback.
+ *
+ *  This function sets the joystick axis callback, or removes the currently set
+ *  callback.  This is called when the value of an axis of any joystick changes.
+ *
+ *  Joystick input is processed by the [event processing](@ref events)
+ *  functions on platforms that support it, so that @ref glfwWaitEvents returns
+ *  when a joystick changes state.  Joystick input is also processed when the
+ *  joystick state is queried, for example with @ref glfwGetJoystickAxes.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int axis, float value)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickaxisfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @x11 @wayland Joystick input is processed by event processing
+ *  functions when Linux joystick support is enabled.
+ *
+ *  @remark @win32 @macos Joystick input is only processed when the joystick
+ *  state is queried.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_axis
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickaxisfun glfwSetJoystickAxisCallback(GLFWjoystickaxisfun callback);
+
+/*! @brief Sets the joystick button callback.
+ *
+ *  This function sets the joystick button callback, or removes the currently
+ *  set callback.  This is called when a button of any joystick is pressed or
+ *  released.  If the [GLFW_JOYSTICK_HAT_BUTTONS](@ref GLFW_JOYSTICK_HAT_BUTTONS)
+ *  init hint is set, this includes the buttons that represent hats.
+ *
+ *  Joystick input is processed by the [event processing](@ref events)
+ *  functions on platforms that support it, so that @ref glfwWaitEvents returns
+ *  when a joystick changes state.  Joystick input is also processed when the
+ *  joystick state is queried, for example with @ref glfwGetJoystickButtons.
+ *
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @callback_signature
+ *  @code
+ *  void function_name(int jid, int button, int action)
+ *  @endcode
+ *  For more information about the callback parameters, see the
+ *  [function pointer type](@ref GLFWjoystickbuttonfun).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @x11 @wayland Joystick input is processed by event processing
+ *  functions when Linux joystick support is enabled.
+ *
+ *  @remark @win32 @macos Joystick input is only processed when the joystick
+ *  state is queried.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref joystick_button
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWjoystickbuttonfun glfwSetJoystickButtonCallback(GLFWjoystickbuttonfun callback);
+
 /*! @brief Adds the specified SDL_GameControllerDB gamepad mappings.
  *
  *  This function parses the specified ASCII encoded string and updates the
@@ -5713,8 +6100,8 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun callback);
  *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
  *  [error](@ref error_handling) occurred.
  *
- *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
- *  GLFW_INVALID_VALUE.
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_OUT_OF_MEMORY.
  *
  *  @thread_safety This function must only be called from the main thread.
  *
@@ -5728,6 +6115,42 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun callback);
  */
 GLFWAPI int glfwUpdateGamepadMappings(const char* string);
 
+/*! @brief Adds the SDL_GameControllerDB gamepad mappings in the specified file.
+ *
+ *  This function reads the specified `gamecontrollerdb.txt` style file and
+ *  updates the internal list with any gamepad mappings it finds, like @ref
+ *  glfwUpdateGamepadMappings.  The file is mapped into memory and parsed in
+ *  place, and lines for other platforms are skipped without being fully
+ *  parsed.
+ *
+ *  See @ref gamepad_mapping for a description of the format.
+ *
+ *  Lines longer than 1023 characters are ignored and counted as too long.
+ *
+ *  @param[in] path The UTF-8 encoded path of the file to read.
+ *  @param[out] accepted Where to store the number of mappings added or
+ *  replaced, or `NULL`.
+ *  @param[out] skipped Where to store the number of mappings skipped because
+ *  they are for another platform or invalid, or `NULL`.
+ *  @param[out] tooLong Where to store the number of mappings skipped because
+ *  they are too long, or `NULL`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE, @ref GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref gamepad_mapping
+ *  @sa @ref glfwUpdateGamepadMappings
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwUpdateGamepadMappingsFromFile(const char* path, int* accepted, int* skipped, int* tooLong);
+
 /*! @brief Returns the human-readable gamepad name for the specified joystick.
  *
  *  This function returns the human-readable name of the gamepad from the
@@ -5798,6 +6221,80 @@ GLFWAPI const char* glfwGetGamepadName(int jid);
  */
 GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state);
 
+/*! @brief Retrieves the state of all joysticks remapped as gamepads.
+ *
+ *  This function retrieves the state of every connected joystick that has
+ *  a gamepad mapping, remapped to an Xbox-like gamepad.  All joysticks are
+ *  polled in a single pass, which is cheaper than calling @ref
+ *  glfwGetGamepadState for each joystick ID.
+ *
+ *  The state of the joystick with ID `jid` is written to element `jid` of the
+ *  array.  Elements for joysticks that are not present or do not have a gamepad
+ *  mapping are set to all buttons released and all axes at 0.0.
+ *
+ *  @param[out] states An array of `GLFW_JOYSTICK_LAST + 1` gamepad states.
+ *  @param[out] connectedMask Where to store a bit mask with bit `jid` set for
+ *  each joystick whose state was retrieved, or `NULL`.
+ *  @return `GLFW_TRUE` if the state of at least one gamepad was retrieved, or
+ *  `GLFW_FALSE` if no gamepad is connected or an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref gamepad
+ *  @sa @ref glfwGetGamepadState
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetGamepadStates(GLFWgamepadstate* states, unsigned int* connectedMask);
+
+/*! @brief Retrieves the most recent state of the specified joystick remapped
+ *  as a gamepad, from any thread.
+ *
+ *  This function retrieves the most recent state of the specified joystick
+ *  remapped to an Xbox-like gamepad, as published by the joystick reader
+ *  thread.  Unlike @ref glfwGetGamepadState, it may be called from any thread,
+ *  does not block and does not make any system calls.
+ *
+ *  The joystick reader thread is only started if the [GLFW_JOYSTICK_THREAD](@ref
+ *  GLFW_JOYSTICK_THREAD) init hint is set and joystick support has been
+ *  initialized, which happens the first time a joystick function is called on
+ *  the main thread, for example @ref glfwSetJoystickCallback.
+ *
+ *  If the specified joystick is not present, does not have a gamepad mapping
+ *  or the joystick reader thread is not running, this function will return
+ *  `GLFW_FALSE` but will not generate an error.
+ *
+ *  @param[in] jid The [joystick](@ref joysticks) to query.
+ *  @param[out] state The gamepad input state of the joystick.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if no joystick is
+ *  connected, it has no gamepad mapping, the reader thread is not running or an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_ENUM.
+ *
+ *  @remark @x11 @wayland The reader thread is only available when Linux
+ *  joystick support is enabled.
+ *
+ *  @remark @win32 @macos The joystick reader thread is not yet implemented and
+ *  this function always returns `GLFW_FALSE`.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref gamepad_thread
+ *  @sa @ref glfwGetGamepadState
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwGetGamepadStateSnapshot(int jid, GLFWgamepadstate* state);
+
 /*! @brief Sets the clipboard to the specified string.
  *
  *  This function sets the system clipboard to the specified, UTF-8 encoded
@@ -5853,6 +6350,42 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* window, const char* string);
  */
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* window);
 
+/*! @brief Requests the contents of the clipboard as a string.
+ *
+ *  This function starts an asynchronous retrieval of the contents of the
+ *  system clipboard, if it contains or is convertible to a UTF-8 encoded
+ *  string.  Unlike @ref glfwGetClipboardString, this function does not wait
+ *  for the clipboard owner to provide the data.
+ *
+ *  The specified callback is called once with the result, as part of event
+ *  processing, when the transfer has completed, failed or timed out.  If no
+ *  data arrives for a few seconds, the request is abandoned and the callback is
+ *  called with `NULL`.  On platforms where the clipboard can be read without
+ *  waiting for another process, the callback is called before this function
+ *  returns.
+ *
+ *  If a request is already in progress, the callback of that request is
+ *  replaced with the specified one and no new transfer is started.
+ *
+ *  @param[in] callback The function to call with the clipboard contents.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_FORMAT_UNAVAILABLE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @win32 @macos @null The clipboard is read immediately and the
+ *  callback is called before this function returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref clipboard
+ *  @sa @ref glfwGetClipboardString
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwRequestClipboardString(GLFWclipboardfun callback);
+
 /*! @brief Returns the GLFW time.
  *
  *  This function returns the current GLFW time, in seconds.  Unless the time
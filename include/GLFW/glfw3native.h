@@ -62,6 +62,7 @@ extern "C" {
  *  * `GLFW_EXPOSE_NATIVE_COCOA`
  *  * `GLFW_EXPOSE_NATIVE_X11`
  *  * `GLFW_EXPOSE_NATIVE_WAYLAND`
+ *  * `GLFW_EXPOSE_NATIVE_NULL`
  *
  *  The available context API macros are:
  *  * `GLFW_EXPOSE_NATIVE_WGL`
@@ -502,6 +503,35 @@ GLFWAPI struct wl_output* glfwGetWaylandMonitor(GLFWmonitor* monitor);
  *  @ingroup native
  */
 GLFWAPI struct wl_surface* glfwGetWaylandWindow(GLFWwindow* window);
+
+/*! @brief Returns whether GLFW has requests waiting to be sent to the compositor.
+ *
+ *  This function returns whether the connection to the compositor is
+ *  backpressured, meaning the last attempt by GLFW to send requests found the
+ *  socket full.  GLFW does not wait for the compositor in this case.  The
+ *  remaining requests are sent by event processing functions like @ref
+ *  glfwPollEvents once the compositor has caught up.
+ *
+ *  You can use this to skip rendering frames instead of stalling while the
+ *  compositor is slow.
+ *
+ *  @return `GLFW_TRUE` if requests are waiting to be sent, or `GLFW_FALSE`
+ *  otherwise or if an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_UNAVAILABLE.
+ *
+ *  @remark Buffer swaps are flushed by the EGL implementation, which may still
+ *  block.
+ *
+ *  @thread_safety This function may be called from any thread.  Access is not
+ *  synchronized.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwGetWaylandFlushPending(void);
 #endif
 
 #if defined(GLFW_EXPOSE_NATIVE_EGL)
@@ -626,6 +656,114 @@ GLFWAPI int glfwGetOSMesaDepthBuffer(GLFWwindow* window, int* width, int* height
 GLFWAPI OSMesaContext glfwGetOSMesaContext(GLFWwindow* window);
 #endif
 
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+/*! @brief Creates a virtual joystick.
+ *
+ *  This function creates a virtual joystick with the specified name, GUID and
+ *  number of axes, buttons and hats, and reports it as connected.  The virtual
+ *  joystick behaves like a physical one, including gamepad mapping by GUID and
+ *  the joystick callbacks, and its state is set with @ref
+ *  glfwSetNullJoystickAxis, @ref glfwSetNullJoystickButton and @ref
+ *  glfwSetNullJoystickHat.
+ *
+ *  All axes start at 0.0, all buttons released and all hats centered.
+ *
+ *  @param[in] name The UTF-8 encoded name of the joystick.
+ *  @param[in] guid The 32 character hexadecimal SDL compatible GUID of the
+ *  joystick.
+ *  @param[in] axisCount The number of axes of the joystick.
+ *  @param[in] buttonCount The number of buttons of the joystick.
+ *  @param[in] hatCount The number of hats of the joystick.
+ *  @return The ID of the virtual joystick, or -1 if all joystick IDs are in
+ *  use or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_UNAVAILABLE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwCreateNullJoystick(const char* name, const char* guid, int axisCount, int buttonCount, int hatCount);
+
+/*! @brief Destroys the specified virtual joystick.
+ *
+ *  This function reports the specified virtual joystick as disconnected and
+ *  destroys it.  Any remaining virtual joysticks are destroyed when the library
+ *  is terminated.
+ *
+ *  @param[in] jid The virtual joystick to destroy.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref
+ *  GLFW_PLATFORM_UNAVAILABLE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwDestroyNullJoystick(int jid);
+
+/*! @brief Sets the value of an axis of the specified virtual joystick.
+ *
+ *  @param[in] jid The virtual joystick to modify.
+ *  @param[in] axis The index of the axis to set.
+ *  @param[in] value The new value of the axis, from -1.0 to 1.0 inclusive.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref
+ *  GLFW_PLATFORM_UNAVAILABLE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwSetNullJoystickAxis(int jid, int axis, float value);
+
+/*! @brief Sets the state of a button of the specified virtual joystick.
+ *
+ *  @param[in] jid The virtual joystick to modify.
+ *  @param[in] button The index of the button to set.
+ *  @param[in] action `GLFW_PRESS` or `GLFW_RELEASE`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref
+ *  GLFW_PLATFORM_UNAVAILABLE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwSetNullJoystickButton(int jid, int button, int action);
+
+/*! @brief Sets the state of a hat of the specified virtual joystick.
+ *
+ *  @param[in] jid The virtual joystick to modify.
+ *  @param[in] hat The index of the hat to set.
+ *  @param[in] state The new [hat state](@ref hat_state), for example
+ *  `GLFW_HAT_RIGHT_UP`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref
+ *  GLFW_PLATFORM_UNAVAILABLE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.4.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwSetNullJoystickHat(int jid, int hat, int state);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -511,11 +511,14 @@ GLFWbool _glfwConnectCocoa(int platformID, _GLFWplatform* platform)
         _glfwGetKeyScancodeCocoa,
         _glfwSetClipboardStringCocoa,
         _glfwGetClipboardStringCocoa,
+        _glfwRequestClipboardStringCocoa,
         _glfwInitJoysticksCocoa,
         _glfwTerminateJoysticksCocoa,
         _glfwPollJoystickCocoa,
+        _glfwPollJoysticksCocoa,
         _glfwGetMappingNameCocoa,
         _glfwUpdateGamepadGUIDCocoa,
+        _glfwGetGamepadSnapshotCocoa,
         _glfwFreeMonitorCocoa,
         _glfwGetMonitorPosCocoa,
         _glfwGetMonitorContentScaleCocoa,
@@ -551,12 +554,16 @@ GLFWbool _glfwConnectCocoa(int platformID, _GLFWplatform* platform)
         _glfwWindowMaximizedCocoa,
         _glfwWindowHoveredCocoa,
         _glfwFramebufferTransparentCocoa,
+        _glfwWindowAsyncPresentationCocoa,
         _glfwGetWindowOpacityCocoa,
         _glfwSetWindowResizableCocoa,
         _glfwSetWindowDecoratedCocoa,
         _glfwSetWindowFloatingCocoa,
         _glfwSetWindowOpacityCocoa,
         _glfwSetWindowMousePassthroughCocoa,
+        _glfwSetWindowAsyncPresentationCocoa,
+        _glfwUpdateWindowEventsCocoa,
+        _glfwWindowReadyForFrameCocoa,
         _glfwPollEventsCocoa,
         _glfwWaitEventsCocoa,
         _glfwWaitEventsTimeoutCocoa,
@@ -44,6 +44,8 @@ typedef struct _GLFWjoystickNS
 GLFWbool _glfwInitJoysticksCocoa(void);
 void _glfwTerminateJoysticksCocoa(void);
 GLFWbool _glfwPollJoystickCocoa(_GLFWjoystick* js, int mode);
+void _glfwPollJoysticksCocoa(void);
 const char* _glfwGetMappingNameCocoa(void);
 void _glfwUpdateGamepadGUIDCocoa(char* guid);
+GLFWbool _glfwGetGamepadSnapshotCocoa(int jid, GLFWgamepadstate* state);
 
@@ -94,23 +94,24 @@ static CFComparisonResult compareElements(const void* fp,
     return kCFCompareEqualTo;
 }
 
+// Frees the specified array of elements and the elements themselves
+//
+static void freeElements(CFMutableArrayRef elements)
+{
+    for (int i = 0;  i < CFArrayGetCount(elements);  i++)
+        _glfw_free((void*) CFArrayGetValueAtIndex(elements, i));
+    CFRelease(elements);
+}
+
 // Removes the specified joystick
 //
 static void closeJoystick(_GLFWjoystick* js)
 {
     _glfwInputJoystick(js, GLFW_DISCONNECTED);
 
-    for (int i = 0;  i < CFArrayGetCount(js->ns.axes);  i++)
-        _glfw_free((void*) CFArrayGetValueAtIndex(js->ns.axes, i));
-    CFRelease(js->ns.axes);
-
-    for (int i = 0;  i < CFArrayGetCount(js->ns.buttons);  i++)
-        _glfw_free((void*) CFArrayGetValueAtIndex(js->ns.buttons, i));
-    CFRelease(js->ns.buttons);
-
-    for (int i = 0;  i < CFArrayGetCount(js->ns.hats);  i++)
-        _glfw_free((void*) CFArrayGetValueAtIndex(js->ns.hats, i));
-    CFRelease(js->ns.hats);
+    freeElements(js->ns.axes);
+    freeElements(js->ns.buttons);
+    freeElements(js->ns.hats);
 
     _glfwFreeJoystick(js);
 }
@@ -271,6 +272,13 @@ static void matchCallback(void* context,
                             (int) CFArrayGetCount(axes),
                             (int) CFArrayGetCount(buttons),
                             (int) CFArrayGetCount(hats));
+    if (!js)
+    {
+        freeElements(axes);
+        freeElements(buttons);
+        freeElements(hats);
+        return;
+    }
 
     js->ns.device  = device;
     js->ns.axes    = axes;
@@ -478,5 +486,19 @@ void _glfwUpdateGamepadGUIDCocoa(char* guid)
     }
 }
 
+void _glfwPollJoysticksCocoa(void)
+{
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (_glfw.joysticks[jid].connected)
+            _glfwPollJoystickCocoa(_glfw.joysticks + jid, _GLFW_POLL_ALL);
+    }
+}
+
+GLFWbool _glfwGetGamepadSnapshotCocoa(int jid, GLFWgamepadstate* state)
+{
+    return GLFW_FALSE;
+}
+
 #endif // _GLFW_COCOA
 
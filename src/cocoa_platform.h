@@ -241,12 +241,16 @@ GLFWbool _glfwWindowVisibleCocoa(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedCocoa(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredCocoa(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentCocoa(_GLFWwindow* window);
+GLFWbool _glfwWindowAsyncPresentationCocoa(_GLFWwindow* window);
 void _glfwSetWindowResizableCocoa(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedCocoa(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowFloatingCocoa(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityCocoa(_GLFWwindow* window);
 void _glfwSetWindowOpacityCocoa(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughCocoa(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowAsyncPresentationCocoa(_GLFWwindow* window, GLFWbool enabled);
+void _glfwUpdateWindowEventsCocoa(_GLFWwindow* window);
+GLFWbool _glfwWindowReadyForFrameCocoa(_GLFWwindow* window);
 
 void _glfwSetRawMouseMotionCocoa(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedCocoa(void);
@@ -267,6 +271,7 @@ void _glfwDestroyCursorCocoa(_GLFWcursor* cursor);
 void _glfwSetCursorCocoa(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringCocoa(const char* string);
 const char* _glfwGetClipboardStringCocoa(void);
+void _glfwRequestClipboardStringCocoa(void);
 
 EGLenum _glfwGetEGLPlatformCocoa(EGLint** attribs);
 EGLNativeDisplayType _glfwGetEGLNativeDisplayCocoa(void);
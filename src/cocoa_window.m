@@ -1422,6 +1422,11 @@ GLFWbool _glfwFramebufferTransparentCocoa(_GLFWwindow* window)
     } // autoreleasepool
 }
 
+GLFWbool _glfwWindowAsyncPresentationCocoa(_GLFWwindow* window)
+{
+    return GLFW_FALSE;
+}
+
 void _glfwSetWindowResizableCocoa(_GLFWwindow* window, GLFWbool enabled)
 {
     @autoreleasepool {
@@ -1485,6 +1490,19 @@ void _glfwSetWindowMousePassthroughCocoa(_GLFWwindow* window, GLFWbool enabled)
     }
 }
 
+void _glfwSetWindowAsyncPresentationCocoa(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
+void _glfwUpdateWindowEventsCocoa(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwWindowReadyForFrameCocoa(_GLFWwindow* window)
+{
+    return GLFW_TRUE;
+}
+
 float _glfwGetWindowOpacityCocoa(_GLFWwindow* window)
 {
     @autoreleasepool {
@@ -1876,6 +1894,11 @@ const char* _glfwGetClipboardStringCocoa(void)
     } // autoreleasepool
 }
 
+void _glfwRequestClipboardStringCocoa(void)
+{
+    _glfwInputClipboardString(_glfwGetClipboardStringCocoa());
+}
+
 EGLenum _glfwGetEGLPlatformCocoa(EGLint** attribs)
 {
     if (_glfw.egl.ANGLE_platform_angle)
@@ -285,6 +285,8 @@ static void swapBuffersEGL(_GLFWwindow* window)
         // NOTE: Swapping buffers on a hidden window on Wayland makes it visible
         if (!window->wl.visible)
             return;
+
+        _glfwPrepareSwapBuffersWayland(window);
     }
 #endif
 
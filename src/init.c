@@ -52,6 +52,8 @@ static GLFWallocator _glfwInitAllocator;
 static _GLFWinitconfig _glfwInitHints =
 {
     GLFW_TRUE,      // hat buttons
+    0,              // joystick sample history
+    GLFW_FALSE,     // joystick reader thread
     GLFW_ANGLE_PLATFORM_TYPE_NONE, // ANGLE backend
     GLFW_ANY_PLATFORM, // preferred platform
     NULL,           // vkGetInstanceProcAddr function
@@ -61,6 +63,7 @@ static _GLFWinitconfig _glfwInitHints =
     },
     {
         GLFW_TRUE,  // X11 XCB Vulkan surface
+        GLFW_DONT_CARE // X11 selection chunk size
     },
     {
         GLFW_WAYLAND_PREFER_LIBDECOR // Wayland libdecor mode
@@ -117,9 +120,11 @@ static void terminate(void)
     _glfw_free(_glfw.mappings);
     _glfw.mappings = NULL;
     _glfw.mappingCount = 0;
+    _glfw.mappingCapacity = 0;
 
     _glfwTerminateVulkan();
     _glfw.platform.terminateJoysticks();
+    _glfwFreeJoystickArrays();
     _glfw.platform.terminate();
 
     _glfw.initialized = GLFW_FALSE;
@@ -269,6 +274,23 @@ float _glfw_fmaxf(float a, float b)
         return b;
 }
 
+void* _glfw_malloc(size_t size)
+{
+    if (size)
+    {
+        void* block = _glfw.allocator.allocate(size, _glfw.allocator.user);
+        if (block)
+            return block;
+        else
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return NULL;
+        }
+    }
+    else
+        return NULL;
+}
+
 void* _glfw_calloc(size_t count, size_t size)
 {
     if (count && size)
@@ -467,6 +489,19 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_JOYSTICK_HAT_BUTTONS:
             _glfwInitHints.hatButtons = value;
             return;
+        case GLFW_JOYSTICK_SAMPLE_HISTORY:
+            if (value < 0 || value > _GLFW_JOYSTICK_SAMPLE_HISTORY_MAX)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid joystick sample history size %i",
+                                value);
+                return;
+            }
+            _glfwInitHints.joystickSampleHistory = value;
+            return;
+        case GLFW_JOYSTICK_THREAD:
+            _glfwInitHints.joystickThread = value;
+            return;
         case GLFW_ANGLE_PLATFORM_TYPE:
             _glfwInitHints.angleType = value;
             return;
@@ -482,6 +517,9 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_X11_XCB_VULKAN_SURFACE:
             _glfwInitHints.x11.xcbVulkanSurface = value;
             return;
+        case GLFW_X11_SELECTION_CHUNK_SIZE:
+            _glfwInitHints.x11.selectionChunkSize = value;
+            return;
         case GLFW_WAYLAND_LIBDECOR:
             _glfwInitHints.wl.libdecorMode = value;
             return;
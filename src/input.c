@@ -44,6 +44,9 @@
 #define _GLFW_JOYSTICK_BUTTON   2
 #define _GLFW_JOYSTICK_HATBIT   3
 
+// Maximum length of an SDL_GameControllerDB line
+#define _GLFW_MAPPING_LINE_MAX  1024
+
 #define GLFW_MOD_MASK (GLFW_MOD_SHIFT | \
                        GLFW_MOD_CONTROL | \
                        GLFW_MOD_ALT | \
@@ -97,6 +100,107 @@ static GLFWbool isValidElementForJoystick(const _GLFWmapelement* e,
     return GLFW_TRUE;
 }
 
+// Compiles a gamepad mapping element into a transform operation
+// Returns GLFW_FALSE if the element is not mapped
+//
+static GLFWbool compileMapElement(const _GLFWmapelement* e,
+                                  GLFWbool button,
+                                  int target,
+                                  _GLFWmapop* op)
+{
+    if (e->type == _GLFW_JOYSTICK_AXIS)
+    {
+        op->index  = e->index;
+        op->mask   = 0;
+        op->scale  = e->axisScale;
+        op->offset = e->axisOffset;
+
+        // A button mapped from an axis is pressed when the transformed value
+        // is at or past zero in the direction of the half axis
+        if (button &&
+            !(e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0)))
+        {
+            op->scale  = -op->scale;
+            op->offset = -op->offset;
+        }
+    }
+    else if (e->type == _GLFW_JOYSTICK_BUTTON || e->type == _GLFW_JOYSTICK_HATBIT)
+    {
+        if (e->type == _GLFW_JOYSTICK_HATBIT)
+        {
+            op->index = e->index >> 4;
+            op->mask  = e->index & 0xf;
+        }
+        else
+        {
+            op->index = e->index;
+            op->mask  = 0;
+        }
+
+        // A button maps to a pressed button at one and to an axis at -1 or 1
+        if (button)
+        {
+            op->scale  = 1.f;
+            op->offset = -0.5f;
+        }
+        else
+        {
+            op->scale  = 2.f;
+            op->offset = -1.f;
+        }
+    }
+    else
+        return GLFW_FALSE;
+
+    op->type   = e->type;
+    op->target = (uint8_t) target;
+    return GLFW_TRUE;
+}
+
+// Compiles the elements of a gamepad mapping into its transform operations
+//
+static void compileMapping(_GLFWmapping* mapping)
+{
+    int i, count = 0;
+
+    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    {
+        if (compileMapElement(mapping->buttons + i, GLFW_TRUE, i,
+                              mapping->ops + count))
+        {
+            count++;
+        }
+    }
+
+    mapping->buttonOpCount = count;
+
+    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    {
+        if (compileMapElement(mapping->axes + i, GLFW_FALSE, i,
+                              mapping->ops + count))
+        {
+            count++;
+        }
+    }
+
+    mapping->axisOpCount = count - mapping->buttonOpCount;
+}
+
+// Reads the source value of a compiled gamepad mapping operation
+//
+static float readMapSource(const _GLFWmapop* op,
+                           const float* axes,
+                           const unsigned char* buttons,
+                           const unsigned char* hats)
+{
+    if (op->type == _GLFW_JOYSTICK_AXIS)
+        return axes[op->index];
+    else if (op->type == _GLFW_JOYSTICK_BUTTON)
+        return buttons[op->index];
+    else
+        return (hats[op->index] & op->mask) ? 1.f : 0.f;
+}
+
 // Finds a mapping based on joystick GUID and verifies element indices
 //
 static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
@@ -117,59 +221,161 @@ static _GLFWmapping* findValidMapping(const _GLFWjoystick* js)
             if (!isValidElementForJoystick(mapping->axes + i, js))
                 return NULL;
         }
+
+        compileMapping(mapping);
     }
 
     return mapping;
 }
 
-// Parses an SDL_GameControllerDB line and adds it to the mapping list
+// Returns the number of characters before the delimiter or the end
 //
-static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
+static size_t spanUntil(const char* c, const char* end, char delimiter)
+{
+    const char* start = c;
+
+    while (c < end && *c != delimiter)
+        c++;
+
+    return (size_t) (c - start);
+}
+
+// Parses a decimal number in a string that may not be null terminated
+// Returns the first character after the number
+//
+static const char* parseDecimal(const char* c, const char* end, unsigned long* value)
+{
+    *value = 0;
+
+    while (c < end && *c >= '0' && *c <= '9')
+    {
+        *value = *value * 10 + (unsigned long) (*c - '0');
+        c++;
+    }
+
+    return c;
+}
+
+// Returns the value of a hexadecimal digit, or -1 if it is not one
+//
+static int parseHexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    else if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    else
+        return -1;
+}
+
+// Returns the mapping element for the specified field name, or NULL if it is
+// not an element field
+//
+static _GLFWmapelement* findMappingElement(_GLFWmapping* mapping,
+                                           const char* name,
+                                           size_t length)
+{
+    switch (length)
+    {
+        case 1:
+            switch (name[0])
+            {
+                case 'a': return mapping->buttons + GLFW_GAMEPAD_BUTTON_A;
+                case 'b': return mapping->buttons + GLFW_GAMEPAD_BUTTON_B;
+                case 'x': return mapping->buttons + GLFW_GAMEPAD_BUTTON_X;
+                case 'y': return mapping->buttons + GLFW_GAMEPAD_BUTTON_Y;
+            }
+            break;
+        case 4:
+            if (memcmp(name, "back", 4) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_BACK;
+            if (memcmp(name, "dpup", 4) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_UP;
+            break;
+        case 5:
+            if (memcmp(name, "start", 5) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_START;
+            if (memcmp(name, "guide", 5) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_GUIDE;
+            if (memcmp(name, "leftx", 5) == 0)
+                return mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_X;
+            if (memcmp(name, "lefty", 5) == 0)
+                return mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_Y;
+            break;
+        case 6:
+            if (memcmp(name, "dpdown", 6) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_DOWN;
+            if (memcmp(name, "dpleft", 6) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_LEFT;
+            if (memcmp(name, "rightx", 6) == 0)
+                return mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_X;
+            if (memcmp(name, "righty", 6) == 0)
+                return mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_Y;
+            break;
+        case 7:
+            if (memcmp(name, "dpright", 7) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_RIGHT;
+            break;
+        case 9:
+            if (memcmp(name, "leftstick", 9) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_THUMB;
+            break;
+        case 10:
+            if (memcmp(name, "rightstick", 10) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_THUMB;
+            break;
+        case 11:
+            if (memcmp(name, "lefttrigger", 11) == 0)
+                return mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_TRIGGER;
+            break;
+        case 12:
+            if (memcmp(name, "leftshoulder", 12) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_BUMPER;
+            if (memcmp(name, "righttrigger", 12) == 0)
+                return mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER;
+            break;
+        case 13:
+            if (memcmp(name, "rightshoulder", 13) == 0)
+                return mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_BUMPER;
+            break;
+    }
+
+    return NULL;
+}
+
+// Parses an SDL_GameControllerDB line that ends at the specified character
+//
+static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string, const char* end)
 {
     const char* c = string;
     size_t i, length;
-    struct
-    {
-        const char* name;
-        _GLFWmapelement* element;
-    } fields[] =
-    {
-        { "platform",      NULL },
-        { "a",             mapping->buttons + GLFW_GAMEPAD_BUTTON_A },
-        { "b",             mapping->buttons + GLFW_GAMEPAD_BUTTON_B },
-        { "x",             mapping->buttons + GLFW_GAMEPAD_BUTTON_X },
-        { "y",             mapping->buttons + GLFW_GAMEPAD_BUTTON_Y },
-        { "back",          mapping->buttons + GLFW_GAMEPAD_BUTTON_BACK },
-        { "start",         mapping->buttons + GLFW_GAMEPAD_BUTTON_START },
-        { "guide",         mapping->buttons + GLFW_GAMEPAD_BUTTON_GUIDE },
-        { "leftshoulder",  mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_BUMPER },
-        { "rightshoulder", mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_BUMPER },
-        { "leftstick",     mapping->buttons + GLFW_GAMEPAD_BUTTON_LEFT_THUMB },
-        { "rightstick",    mapping->buttons + GLFW_GAMEPAD_BUTTON_RIGHT_THUMB },
-        { "dpup",          mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_UP },
-        { "dpright",       mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_RIGHT },
-        { "dpdown",        mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_DOWN },
-        { "dpleft",        mapping->buttons + GLFW_GAMEPAD_BUTTON_DPAD_LEFT },
-        { "lefttrigger",   mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_TRIGGER },
-        { "righttrigger",  mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER },
-        { "leftx",         mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_X },
-        { "lefty",         mapping->axes + GLFW_GAMEPAD_AXIS_LEFT_Y },
-        { "rightx",        mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_X },
-        { "righty",        mapping->axes + GLFW_GAMEPAD_AXIS_RIGHT_Y }
-    };
-
-    length = strcspn(c, ",");
-    if (length != 32 || c[length] != ',')
+
+    length = spanUntil(c, end, ',');
+    if (length != 32 || c + length == end)
     {
         _glfwInputError(GLFW_INVALID_VALUE, NULL);
         return GLFW_FALSE;
     }
 
-    memcpy(mapping->guid, c, length);
+    // Validate the GUID and convert it to lowercase in one pass
+    for (i = 0;  i < 32;  i++)
+    {
+        const int digit = parseHexDigit(c[i]);
+        if (digit < 0)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE, "Invalid gamepad GUID");
+            return GLFW_FALSE;
+        }
+
+        mapping->guid[i] = "0123456789abcdef"[digit];
+    }
+
     c += length + 1;
 
-    length = strcspn(c, ",");
-    if (length >= sizeof(mapping->name) || c[length] != ',')
+    length = spanUntil(c, end, ',');
+    if (length >= sizeof(mapping->name) || c + length == end)
     {
         _glfwInputError(GLFW_INVALID_VALUE, NULL);
         return GLFW_FALSE;
@@ -178,92 +384,206 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
     memcpy(mapping->name, c, length);
     c += length + 1;
 
-    while (*c)
+    while (c < end)
     {
+        const size_t fieldLength = spanUntil(c, end, ',');
+        const char* fieldEnd = c + fieldLength;
+
         // TODO: Implement output modifiers
         if (*c == '+' || *c == '-')
             return GLFW_FALSE;
 
-        for (i = 0;  i < sizeof(fields) / sizeof(fields[0]);  i++)
+        length = spanUntil(c, fieldEnd, ':');
+        if (c + length < fieldEnd)
         {
-            length = strlen(fields[i].name);
-            if (strncmp(c, fields[i].name, length) != 0 || c[length] != ':')
-                continue;
+            const char* name = c;
+            _GLFWmapelement* e = findMappingElement(mapping, name, length);
 
             c += length + 1;
 
-            if (fields[i].element)
+            if (e)
             {
-                _GLFWmapelement* e = fields[i].element;
                 int8_t minimum = -1;
                 int8_t maximum = 1;
+                uint8_t type = 0;
 
-                if (*c == '+')
+                if (c < fieldEnd && *c == '+')
                 {
                     minimum = 0;
                     c += 1;
                 }
-                else if (*c == '-')
+                else if (c < fieldEnd && *c == '-')
                 {
                     maximum = 0;
                     c += 1;
                 }
 
-                if (*c == 'a')
-                    e->type = _GLFW_JOYSTICK_AXIS;
-                else if (*c == 'b')
-                    e->type = _GLFW_JOYSTICK_BUTTON;
-                else if (*c == 'h')
-                    e->type = _GLFW_JOYSTICK_HATBIT;
-                else
-                    break;
+                if (c < fieldEnd)
+                {
+                    if (*c == 'a')
+                        type = _GLFW_JOYSTICK_AXIS;
+                    else if (*c == 'b')
+                        type = _GLFW_JOYSTICK_BUTTON;
+                    else if (*c == 'h')
+                        type = _GLFW_JOYSTICK_HATBIT;
+                }
 
-                if (e->type == _GLFW_JOYSTICK_HATBIT)
+                if (type == _GLFW_JOYSTICK_HATBIT)
                 {
-                    const unsigned long hat = strtoul(c + 1, (char**) &c, 10);
-                    const unsigned long bit = strtoul(c + 1, (char**) &c, 10);
+                    unsigned long hat, bit = 0;
+                    c = parseDecimal(c + 1, fieldEnd, &hat);
+                    if (c < fieldEnd)
+                        c = parseDecimal(c + 1, fieldEnd, &bit);
+                    e->type = type;
                     e->index = (uint8_t) ((hat << 4) | bit);
                 }
-                else
-                    e->index = (uint8_t) strtoul(c + 1, (char**) &c, 10);
+                else if (type)
+                {
+                    unsigned long index;
+                    c = parseDecimal(c + 1, fieldEnd, &index);
+                    e->type = type;
+                    e->index = (uint8_t) index;
+                }
 
-                if (e->type == _GLFW_JOYSTICK_AXIS)
+                if (type == _GLFW_JOYSTICK_AXIS)
                 {
                     e->axisScale = 2 / (maximum - minimum);
                     e->axisOffset = -(maximum + minimum);
 
-                    if (*c == '~')
+                    if (c < fieldEnd && *c == '~')
                     {
                         e->axisScale = -e->axisScale;
                         e->axisOffset = -e->axisOffset;
                     }
                 }
             }
-            else
+            else if (length == 8 && memcmp(name, "platform", 8) == 0)
             {
-                const char* name = _glfw.platform.getMappingName();
-                length = strlen(name);
-                if (strncmp(c, name, length) != 0)
+                const char* platform = _glfw.platform.getMappingName();
+                const size_t platformLength = strlen(platform);
+                if ((size_t) (end - c) < platformLength ||
+                    memcmp(c, platform, platformLength) != 0)
+                {
                     return GLFW_FALSE;
+                }
             }
+        }
 
-            break;
+        c = fieldEnd;
+        while (c < end && *c == ',')
+            c++;
+    }
+
+    _glfw.platform.updateGamepadGUID(mapping->guid);
+    return GLFW_TRUE;
+}
+
+// Checks whether the platform field of an SDL_GameControllerDB line, if any,
+// matches the current platform, without parsing the rest of the line
+//
+static GLFWbool isMappingForPlatform(const char* c, const char* end)
+{
+    const char* name = _glfw.platform.getMappingName();
+    const size_t length = strlen(name);
+
+    // The platform field is usually the last one, so search from the end
+    while (end > c)
+    {
+        const char* field = end;
+        while (field > c && field[-1] != ',')
+            field--;
+
+        if (end - field >= 9 && memcmp(field, "platform:", 9) == 0)
+        {
+            field += 9;
+            return (size_t) (end - field) >= length &&
+                   memcmp(field, name, length) == 0;
         }
 
-        c += strcspn(c, ",");
-        c += strspn(c, ",");
+        end = field - 1;
     }
 
-    for (i = 0;  i < 32;  i++)
+    return GLFW_TRUE;
+}
+
+// Adds or replaces gamepad mappings from SDL_GameControllerDB lines
+// Returns whether all lines were processed
+//
+static GLFWbool updateMappings(const char* c, const char* end,
+                               int* accepted, int* skipped, int* tooLong)
+{
+    while (c < end)
     {
-        if (mapping->guid[i] >= 'A' && mapping->guid[i] <= 'F')
-            mapping->guid[i] += 'a' - 'A';
+        size_t length = 0;
+
+        while (c + length < end && c[length] != '\r' && c[length] != '\n')
+            length++;
+
+        if ((*c >= '0' && *c <= '9') ||
+            (*c >= 'a' && *c <= 'f') ||
+            (*c >= 'A' && *c <= 'F'))
+        {
+            _GLFWmapping mapping = {{0}};
+
+            if (length >= _GLFW_MAPPING_LINE_MAX)
+                (*tooLong)++;
+            else if (!isMappingForPlatform(c, c + length) ||
+                     !parseMapping(&mapping, c, c + length))
+            {
+                (*skipped)++;
+            }
+            else
+            {
+                _GLFWmapping* previous = findMapping(mapping.guid);
+                if (previous)
+                    *previous = mapping;
+                else
+                {
+                    if (_glfw.mappingCount == _glfw.mappingCapacity)
+                    {
+                        const int capacity =
+                            _glfw.mappingCapacity ? _glfw.mappingCapacity * 2 : 64;
+
+                        // The allocator reports GLFW_OUT_OF_MEMORY on failure
+                        _GLFWmapping* mappings =
+                            _glfw_realloc(_glfw.mappings,
+                                          sizeof(_GLFWmapping) * capacity);
+                        if (!mappings)
+                            return GLFW_FALSE;
+
+                        _glfw.mappings = mappings;
+                        _glfw.mappingCapacity = capacity;
+                    }
+
+                    _glfw.mappings[_glfw.mappingCount++] = mapping;
+                }
+
+                (*accepted)++;
+            }
+        }
+
+        c += length;
+        while (c < end && (*c == '\r' || *c == '\n'))
+            c++;
     }
 
-    _glfw.platform.updateGamepadGUID(mapping->guid);
     return GLFW_TRUE;
 }
 
+// Reassigns the gamepad mappings of connected joysticks
+//
+static void updateJoystickMappings(void)
+{
+    int jid;
+
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+        if (js->connected)
+            js->mapping = findValidMapping(js);
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -429,6 +749,39 @@ void _glfwInputJoystick(_GLFWjoystick* js, int event)
         _glfw.callbacks.joystick((int) (js - _glfw.joysticks), event);
 }
 
+// Appends a sample to the input history of the specified joystick
+//
+static void recordJoystickSample(_GLFWjoystick* js,
+                                 int type, int index, float value, int state)
+{
+    uint64_t time;
+    GLFWjoysticksample* sample;
+
+    if (!js->samples)
+        return;
+
+    // Discard the oldest sample if the history is full
+    if (js->sampleCount == js->sampleCapacity)
+    {
+        js->sampleFirst = (js->sampleFirst + 1) % js->sampleCapacity;
+        js->sampleCount--;
+    }
+
+    time = js->inputTime;
+    if (!time)
+        time = _glfwPlatformGetTimerValue();
+
+    sample = js->samples +
+        (js->sampleFirst + js->sampleCount) % js->sampleCapacity;
+    sample->time = (double) (int64_t) (time - _glfw.timer.offset) /
+        _glfwPlatformGetTimerFrequency();
+    sample->type = type;
+    sample->index = index;
+    sample->value = value;
+    sample->state = state;
+    js->sampleCount++;
+}
+
 // Notifies shared code of the new value of a joystick axis
 //
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value)
@@ -437,7 +790,14 @@ void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value)
     assert(axis >= 0);
     assert(axis < js->axisCount);
 
+    if (js->axes[axis] == value)
+        return;
+
     js->axes[axis] = value;
+    recordJoystickSample(js, GLFW_JOYSTICK_AXIS_SAMPLE, axis, value, 0);
+
+    if (_glfw.callbacks.joystickAxis)
+        _glfw.callbacks.joystickAxis((int) (js - _glfw.joysticks), axis, value);
 }
 
 // Notifies shared code of the new value of a joystick button
@@ -449,14 +809,21 @@ void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value)
     assert(button < js->buttonCount);
     assert(value == GLFW_PRESS || value == GLFW_RELEASE);
 
+    if (js->buttons[button] == value)
+        return;
+
     js->buttons[button] = value;
+    recordJoystickSample(js, GLFW_JOYSTICK_BUTTON_SAMPLE, button, 0.f, value);
+
+    if (_glfw.callbacks.joystickButton)
+        _glfw.callbacks.joystickButton((int) (js - _glfw.joysticks), button, value);
 }
 
 // Notifies shared code of the new value of a joystick hat
 //
 void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value)
 {
-    int base;
+    int i, base;
 
     assert(js != NULL);
     assert(hat >= 0);
@@ -469,12 +836,38 @@ void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value)
 
     base = js->buttonCount + hat * 4;
 
-    js->buttons[base + 0] = (value & 0x01) ? GLFW_PRESS : GLFW_RELEASE;
-    js->buttons[base + 1] = (value & 0x02) ? GLFW_PRESS : GLFW_RELEASE;
-    js->buttons[base + 2] = (value & 0x04) ? GLFW_PRESS : GLFW_RELEASE;
-    js->buttons[base + 3] = (value & 0x08) ? GLFW_PRESS : GLFW_RELEASE;
+    for (i = 0;  i < 4;  i++)
+    {
+        const char action = (value & (1 << i)) ? GLFW_PRESS : GLFW_RELEASE;
+        if (js->buttons[base + i] == action)
+            continue;
+
+        js->buttons[base + i] = action;
+
+        // Hat buttons are only reported if they are exposed as buttons
+        if (_glfw.callbacks.joystickButton && _glfw.hints.init.hatButtons)
+        {
+            _glfw.callbacks.joystickButton((int) (js - _glfw.joysticks),
+                                           base + i, action);
+        }
+    }
+
+    if (js->hats[hat] != value)
+    {
+        js->hats[hat] = value;
+        recordJoystickSample(js, GLFW_JOYSTICK_HAT_SAMPLE, hat, 0.f, value);
+    }
+}
+
+// Notifies shared code of the result of an asynchronous clipboard request
+//
+void _glfwInputClipboardString(const char* string)
+{
+    const GLFWclipboardfun callback = _glfw.callbacks.clipboard;
+    _glfw.callbacks.clipboard = NULL;
 
-    js->hats[hat] = value;
+    if (callback)
+        callback(string);
 }
 
 
@@ -489,11 +882,19 @@ void _glfwInitGamepadMappings(void)
     size_t i;
     const size_t count = sizeof(_glfwDefaultMappings) / sizeof(char*);
     _glfw.mappings = _glfw_calloc(count, sizeof(_GLFWmapping));
+    if (!_glfw.mappings)
+        return;
+
+    _glfw.mappingCapacity = (int) count;
 
     for (i = 0;  i < count;  i++)
     {
-        if (parseMapping(&_glfw.mappings[_glfw.mappingCount], _glfwDefaultMappings[i]))
+        const char* string = _glfwDefaultMappings[i];
+        if (parseMapping(&_glfw.mappings[_glfw.mappingCount],
+                         string, string + strlen(string)))
+        {
             _glfw.mappingCount++;
+        }
     }
 }
 
@@ -518,10 +919,56 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
         return NULL;
 
     js = _glfw.joysticks + jid;
+
+    // Reuse the arrays of a previous joystick in this slot if they are large enough
+    if (js->axisCapacity < axisCount)
+    {
+        _glfw_free(js->axes);
+        js->axisCapacity = 0;
+        js->axes = _glfw_calloc(axisCount, sizeof(float));
+        if (!js->axes)
+            return NULL;
+
+        js->axisCapacity = axisCount;
+    }
+    else if (axisCount)
+        memset(js->axes, 0, axisCount * sizeof(float));
+
+    if (js->buttonCapacity < buttonCount + hatCount * 4)
+    {
+        _glfw_free(js->buttons);
+        js->buttonCapacity = 0;
+        js->buttons = _glfw_calloc(buttonCount + (size_t) hatCount * 4, 1);
+        if (!js->buttons)
+            return NULL;
+
+        js->buttonCapacity = buttonCount + hatCount * 4;
+    }
+    else if (buttonCount + hatCount * 4)
+        memset(js->buttons, 0, buttonCount + (size_t) hatCount * 4);
+
+    if (js->hatCapacity < hatCount)
+    {
+        _glfw_free(js->hats);
+        js->hatCapacity = 0;
+        js->hats = _glfw_calloc(hatCount, 1);
+        if (!js->hats)
+            return NULL;
+
+        js->hatCapacity = hatCount;
+    }
+    else if (hatCount)
+        memset(js->hats, 0, hatCount);
+
+    if (!js->samples && _glfw.hints.init.joystickSampleHistory > 0)
+    {
+        js->samples = _glfw_calloc(_glfw.hints.init.joystickSampleHistory,
+                                   sizeof(GLFWjoysticksample));
+        if (js->samples)
+            js->sampleCapacity = _glfw.hints.init.joystickSampleHistory;
+    }
+
     js->allocated   = GLFW_TRUE;
-    js->axes        = _glfw_calloc(axisCount, sizeof(float));
-    js->buttons     = _glfw_calloc(buttonCount + (size_t) hatCount * 4, 1);
-    js->hats        = _glfw_calloc(hatCount, 1);
     js->axisCount   = axisCount;
     js->buttonCount = buttonCount;
     js->hatCount    = hatCount;
@@ -533,14 +980,75 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
     return js;
 }
 
-// Frees arrays and name and flags the joystick object as unused
+// Clears and flags the joystick object as unused, keeping its arrays for reuse
 //
 void _glfwFreeJoystick(_GLFWjoystick* js)
 {
-    _glfw_free(js->axes);
-    _glfw_free(js->buttons);
-    _glfw_free(js->hats);
+    float* axes = js->axes;
+    unsigned char* buttons = js->buttons;
+    unsigned char* hats = js->hats;
+    GLFWjoysticksample* samples = js->samples;
+    const int axisCapacity = js->axisCapacity;
+    const int buttonCapacity = js->buttonCapacity;
+    const int hatCapacity = js->hatCapacity;
+    const int sampleCapacity = js->sampleCapacity;
+
     memset(js, 0, sizeof(_GLFWjoystick));
+
+    js->axes = axes;
+    js->buttons = buttons;
+    js->hats = hats;
+    js->samples = samples;
+    js->axisCapacity = axisCapacity;
+    js->buttonCapacity = buttonCapacity;
+    js->hatCapacity = hatCapacity;
+    js->sampleCapacity = sampleCapacity;
+}
+
+// Frees the arrays kept for reuse by all joystick objects
+//
+void _glfwFreeJoystickArrays(void)
+{
+    int jid;
+
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        _GLFWjoystick* js = _glfw.joysticks + jid;
+        _glfw_free(js->axes);
+        _glfw_free(js->buttons);
+        _glfw_free(js->hats);
+        _glfw_free(js->samples);
+        memset(js, 0, sizeof(_GLFWjoystick));
+    }
+}
+
+// Applies a gamepad mapping to the specified joystick state
+//
+void _glfwApplyGamepadMapping(const _GLFWmapping* mapping,
+                              const float* axes,
+                              const unsigned char* buttons,
+                              const unsigned char* hats,
+                              GLFWgamepadstate* state)
+{
+    const _GLFWmapop* op = mapping->ops;
+    const _GLFWmapop* end = op + mapping->buttonOpCount;
+
+    memset(state, 0, sizeof(GLFWgamepadstate));
+
+    for (;  op < end;  op++)
+    {
+        const float value = readMapSource(op, axes, buttons, hats);
+        state->buttons[op->target] = value * op->scale + op->offset >= 0.f;
+    }
+
+    end += mapping->axisOpCount;
+
+    for (;  op < end;  op++)
+    {
+        const float value = readMapSource(op, axes, buttons, hats);
+        state->axes[op->target] =
+            _glfw_fminf(_glfw_fmaxf(value * op->scale + op->offset, -1.f), 1.f);
+    }
 }
 
 // Center the cursor in the content area of the specified window
@@ -577,6 +1085,8 @@ GLFWAPI int glfwGetInputMode(GLFWwindow* handle, int mode)
             return window->lockKeyMods;
         case GLFW_RAW_MOUSE_MOTION:
             return window->rawMouseMotion;
+        case GLFW_KEY_REPEAT_LIMIT:
+            return window->keyRepeatLimit;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -684,6 +1194,20 @@ GLFWAPI void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
             _glfw.platform.setRawMouseMotion(window, value);
             return;
         }
+
+        case GLFW_KEY_REPEAT_LIMIT:
+        {
+            if (value < 0)
+            {
+                _glfwInputError(GLFW_INVALID_VALUE,
+                                "Invalid key repeat limit %i",
+                                value);
+                return;
+            }
+
+            window->keyRepeatLimit = value;
+            return;
+        }
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -955,6 +1479,7 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* handle, GLFWcharfun cbfun)
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP(GLFWcharfun, window->callbacks.character, cbfun);
+    _glfw.platform.updateWindowEvents(window);
     return cbfun;
 }
 
@@ -965,6 +1490,7 @@ GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* handle, GLFWcharmods
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP(GLFWcharmodsfun, window->callbacks.charmods, cbfun);
+    _glfw.platform.updateWindowEvents(window);
     return cbfun;
 }
 
@@ -987,6 +1513,7 @@ GLFWAPI GLFWcursorposfun glfwSetCursorPosCallback(GLFWwindow* handle,
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP(GLFWcursorposfun, window->callbacks.cursorPos, cbfun);
+    _glfw.platform.updateWindowEvents(window);
     return cbfun;
 }
 
@@ -998,6 +1525,7 @@ GLFWAPI GLFWcursorenterfun glfwSetCursorEnterCallback(GLFWwindow* handle,
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP(GLFWcursorenterfun, window->callbacks.cursorEnter, cbfun);
+    _glfw.platform.updateWindowEvents(window);
     return cbfun;
 }
 
@@ -1147,6 +1675,55 @@ GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count)
     return js->hats;
 }
 
+GLFWAPI int glfwGetJoystickSamples(int jid, GLFWjoysticksample* samples, int count)
+{
+    int i;
+    _GLFWjoystick* js;
+
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+    assert(samples != NULL || count == 0);
+    assert(count >= 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return 0;
+    }
+
+    if (count < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid sample count %i", count);
+        return 0;
+    }
+
+    if (!initJoysticks())
+        return 0;
+
+    js = _glfw.joysticks + jid;
+    if (!js->connected)
+        return 0;
+
+    if (!_glfw.platform.pollJoystick(js, _GLFW_POLL_ALL))
+        return 0;
+
+    if (count > js->sampleCount)
+        count = js->sampleCount;
+
+    for (i = 0;  i < count;  i++)
+        samples[i] = js->samples[(js->sampleFirst + i) % js->sampleCapacity];
+
+    if (count)
+    {
+        js->sampleFirst = (js->sampleFirst + count) % js->sampleCapacity;
+        js->sampleCount -= count;
+    }
+
+    return count;
+}
+
 GLFWAPI const char* glfwGetJoystickName(int jid)
 {
     _GLFWjoystick* js;
@@ -1246,64 +1823,86 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun cbfun)
     return cbfun;
 }
 
+GLFWAPI GLFWjoystickaxisfun glfwSetJoystickAxisCallback(GLFWjoystickaxisfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (!initJoysticks())
+        return NULL;
+
+    _GLFW_SWAP(GLFWjoystickaxisfun, _glfw.callbacks.joystickAxis, cbfun);
+    return cbfun;
+}
+
+GLFWAPI GLFWjoystickbuttonfun glfwSetJoystickButtonCallback(GLFWjoystickbuttonfun cbfun)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (!initJoysticks())
+        return NULL;
+
+    _GLFW_SWAP(GLFWjoystickbuttonfun, _glfw.callbacks.joystickButton, cbfun);
+    return cbfun;
+}
+
 GLFWAPI int glfwUpdateGamepadMappings(const char* string)
 {
-    int jid;
-    const char* c = string;
+    int accepted = 0, skipped = 0, tooLong = 0;
+    GLFWbool result;
 
     assert(string != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
 
-    while (*c)
-    {
-        if ((*c >= '0' && *c <= '9') ||
-            (*c >= 'a' && *c <= 'f') ||
-            (*c >= 'A' && *c <= 'F'))
-        {
-            char line[1024];
+    result = updateMappings(string, string + strlen(string),
+                            &accepted, &skipped, &tooLong);
+    // The mapping array may have moved even if not all lines were processed
+    updateJoystickMappings();
+    return result;
+}
 
-            const size_t length = strcspn(c, "\r\n");
-            if (length < sizeof(line))
-            {
-                _GLFWmapping mapping = {{0}};
+GLFWAPI int glfwUpdateGamepadMappingsFromFile(const char* path,
+                                              int* accepted,
+                                              int* skipped,
+                                              int* tooLong)
+{
+    int acceptedCount = 0, skippedCount = 0, tooLongCount = 0;
+    void* data;
+    size_t size;
+    GLFWbool result;
 
-                memcpy(line, c, length);
-                line[length] = '\0';
+    assert(path != NULL);
 
-                if (parseMapping(&mapping, line))
-                {
-                    _GLFWmapping* previous = findMapping(mapping.guid);
-                    if (previous)
-                        *previous = mapping;
-                    else
-                    {
-                        _glfw.mappingCount++;
-                        _glfw.mappings =
-                            _glfw_realloc(_glfw.mappings,
-                                          sizeof(_GLFWmapping) * _glfw.mappingCount);
-                        _glfw.mappings[_glfw.mappingCount - 1] = mapping;
-                    }
-                }
-            }
+    if (accepted)
+        *accepted = 0;
+    if (skipped)
+        *skipped = 0;
+    if (tooLong)
+        *tooLong = 0;
 
-            c += length;
-        }
-        else
-        {
-            c += strcspn(c, "\r\n");
-            c += strspn(c, "\r\n");
-        }
-    }
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
 
-    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    if (!_glfwPlatformMapFile(path, &data, &size))
     {
-        _GLFWjoystick* js = _glfw.joysticks + jid;
-        if (js->connected)
-            js->mapping = findValidMapping(js);
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to open gamepad mapping file %s", path);
+        return GLFW_FALSE;
     }
 
-    return GLFW_TRUE;
+    result = updateMappings(data, (const char*) data + size,
+                            &acceptedCount, &skippedCount, &tooLongCount);
+    _glfwPlatformUnmapFile(data, size);
+    // The mapping array may have moved even if not all lines were processed
+    updateJoystickMappings();
+
+    if (accepted)
+        *accepted = acceptedCount;
+    if (skipped)
+        *skipped = skippedCount;
+    if (tooLong)
+        *tooLong = tooLongCount;
+
+    return result;
 }
 
 GLFWAPI int glfwJoystickIsGamepad(int jid)
@@ -1367,7 +1966,6 @@ GLFWAPI const char* glfwGetGamepadName(int jid)
 
 GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
 {
-    int i;
     _GLFWjoystick* js;
 
     assert(jid >= GLFW_JOYSTICK_1);
@@ -1397,55 +1995,67 @@ GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
     if (!js->mapping)
         return GLFW_FALSE;
 
-    for (i = 0;  i <= GLFW_GAMEPAD_BUTTON_LAST;  i++)
+    _glfwApplyGamepadMapping(js->mapping, js->axes, js->buttons, js->hats, state);
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI int glfwGetGamepadStates(GLFWgamepadstate* states,
+                                 unsigned int* connectedMask)
+{
+    int jid;
+    unsigned int mask = 0;
+
+    assert(states != NULL);
+
+    memset(states, 0, sizeof(GLFWgamepadstate) * (GLFW_JOYSTICK_LAST + 1));
+    if (connectedMask)
+        *connectedMask = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!initJoysticks())
+        return GLFW_FALSE;
+
+    _glfw.platform.pollJoysticks();
+
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
-        const _GLFWmapelement* e = js->mapping->buttons + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            // HACK: This should be baked into the value transform
-            // TODO: Bake into transform when implementing output modifiers
-            if (e->axisOffset < 0 || (e->axisOffset == 0 && e->axisScale > 0))
-            {
-                if (value >= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-            else
-            {
-                if (value <= 0.f)
-                    state->buttons[i] = GLFW_PRESS;
-            }
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->buttons[i] = GLFW_PRESS;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->buttons[i] = js->buttons[e->index];
+        const _GLFWjoystick* js = _glfw.joysticks + jid;
+        if (!js->connected || !js->mapping)
+            continue;
+
+        _glfwApplyGamepadMapping(js->mapping, js->axes, js->buttons, js->hats,
+                                 states + jid);
+        mask |= 1u << jid;
     }
 
-    for (i = 0;  i <= GLFW_GAMEPAD_AXIS_LAST;  i++)
+    if (connectedMask)
+        *connectedMask = mask;
+
+    return mask != 0;
+}
+
+GLFWAPI int glfwGetGamepadStateSnapshot(int jid, GLFWgamepadstate* state)
+{
+    assert(jid >= GLFW_JOYSTICK_1);
+    assert(jid <= GLFW_JOYSTICK_LAST);
+    assert(state != NULL);
+
+    memset(state, 0, sizeof(GLFWgamepadstate));
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
     {
-        const _GLFWmapelement* e = js->mapping->axes + i;
-        if (e->type == _GLFW_JOYSTICK_AXIS)
-        {
-            const float value = js->axes[e->index] * e->axisScale + e->axisOffset;
-            state->axes[i] = _glfw_fminf(_glfw_fmaxf(value, -1.f), 1.f);
-        }
-        else if (e->type == _GLFW_JOYSTICK_HATBIT)
-        {
-            const unsigned int hat = e->index >> 4;
-            const unsigned int bit = e->index & 0xf;
-            if (js->hats[hat] & bit)
-                state->axes[i] = 1.f;
-            else
-                state->axes[i] = -1.f;
-        }
-        else if (e->type == _GLFW_JOYSTICK_BUTTON)
-            state->axes[i] = js->buttons[e->index] * 2.f - 1.f;
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return GLFW_FALSE;
+    }
+
+    if (!_glfw.platform.getGamepadSnapshot(jid, state))
+    {
+        memset(state, 0, sizeof(GLFWgamepadstate));
+        return GLFW_FALSE;
     }
 
     return GLFW_TRUE;
@@ -1465,6 +2075,23 @@ GLFWAPI const char* glfwGetClipboardString(GLFWwindow* handle)
     return _glfw.platform.getClipboardString();
 }
 
+GLFWAPI void glfwRequestClipboardString(GLFWclipboardfun callback)
+{
+    assert(callback != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (_glfw.callbacks.clipboard)
+    {
+        // Replace the callback of the request already in progress
+        _glfw.callbacks.clipboard = callback;
+        return;
+    }
+
+    _glfw.callbacks.clipboard = callback;
+    _glfw.platform.requestClipboardString();
+}
+
 GLFWAPI double glfwGetTime(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0.0);
@@ -58,6 +58,12 @@
 
 #define _GLFW_MESSAGE_SIZE      1024
 
+// Seconds without progress before an asynchronous clipboard request is abandoned
+#define _GLFW_CLIPBOARD_TIMEOUT 5.0
+
+// Largest number of input samples that may be kept for each joystick
+#define _GLFW_JOYSTICK_SAMPLE_HISTORY_MAX 65536
+
 typedef int GLFWbool;
 typedef void (*GLFWproc)(void);
 
@@ -73,6 +79,7 @@ typedef struct _GLFWlibrary     _GLFWlibrary;
 typedef struct _GLFWmonitor     _GLFWmonitor;
 typedef struct _GLFWcursor      _GLFWcursor;
 typedef struct _GLFWmapelement  _GLFWmapelement;
+typedef struct _GLFWmapop       _GLFWmapop;
 typedef struct _GLFWmapping     _GLFWmapping;
 typedef struct _GLFWjoystick    _GLFWjoystick;
 typedef struct _GLFWtls         _GLFWtls;
@@ -369,6 +376,8 @@ struct _GLFWerror
 struct _GLFWinitconfig
 {
     GLFWbool      hatButtons;
+    int           joystickSampleHistory;
+    GLFWbool      joystickThread;
     int           angleType;
     int           platformID;
     PFN_vkGetInstanceProcAddr vulkanLoader;
@@ -378,6 +387,7 @@ struct _GLFWinitconfig
     } ns;
     struct {
         GLFWbool  xcbVulkanSurface;
+        int       selectionChunkSize;
     } x11;
     struct {
         int       libdecorMode;
@@ -407,6 +417,7 @@ struct _GLFWwndconfig
     GLFWbool      centerCursor;
     GLFWbool      focusOnShow;
     GLFWbool      mousePassthrough;
+    GLFWbool      asyncPresentation;
     GLFWbool      scaleToMonitor;
     struct {
         GLFWbool  retina;
@@ -551,6 +562,7 @@ struct _GLFWwindow
     // Virtual cursor position when cursor is disabled
     double              virtualCursorPosX, virtualCursorPosY;
     GLFWbool            rawMouseMotion;
+    int                 keyRepeatLimit;
 
     _GLFWcontext        context;
 
@@ -564,6 +576,7 @@ struct _GLFWwindow
         GLFWwindowmaximizefun     maximize;
         GLFWframebuffersizefun    fbsize;
         GLFWwindowcontentscalefun scale;
+        GLFWwindowpresentfun      present;
         GLFWmousebuttonfun        mouseButton;
         GLFWcursorposfun          cursorPos;
         GLFWcursorenterfun        cursorEnter;
@@ -621,6 +634,20 @@ struct _GLFWmapelement
     int8_t          axisOffset;
 };
 
+// Compiled gamepad mapping operation
+// The output is source * scale + offset, where a button source is zero or one
+// and a hat bit source is one if any bit in the mask is set
+//
+struct _GLFWmapop
+{
+    float           scale;
+    float           offset;
+    uint8_t         type;
+    uint8_t         index;
+    uint8_t         mask;
+    uint8_t         target;
+};
+
 // Gamepad mapping structure
 //
 struct _GLFWmapping
@@ -629,6 +656,10 @@ struct _GLFWmapping
     char            guid[33];
     _GLFWmapelement buttons[15];
     _GLFWmapelement axes[6];
+    // Mapped buttons followed by mapped axes, compiled by findValidMapping
+    _GLFWmapop      ops[15 + 6];
+    int             buttonOpCount;
+    int             axisOpCount;
 };
 
 // Joystick structure
@@ -639,14 +670,23 @@ struct _GLFWjoystick
     GLFWbool        connected;
     float*          axes;
     int             axisCount;
+    int             axisCapacity;
     unsigned char*  buttons;
     int             buttonCount;
+    int             buttonCapacity;
     unsigned char*  hats;
     int             hatCount;
+    int             hatCapacity;
     char            name[128];
     void*           userPointer;
     char            guid[33];
     _GLFWmapping*   mapping;
+    GLFWjoysticksample* samples;
+    int             sampleCapacity;
+    int             sampleFirst;
+    int             sampleCount;
+    // Timer value of the input being reported, or zero for the current time
+    uint64_t        inputTime;
 
     // This is defined in platform.h
     GLFW_PLATFORM_JOYSTICK_STATE
@@ -690,11 +730,14 @@ struct _GLFWplatform
     int (*getKeyScancode)(int);
     void (*setClipboardString)(const char*);
     const char* (*getClipboardString)(void);
+    void (*requestClipboardString)(void);
     GLFWbool (*initJoysticks)(void);
     void (*terminateJoysticks)(void);
     GLFWbool (*pollJoystick)(_GLFWjoystick*,int);
+    void (*pollJoysticks)(void);
     const char* (*getMappingName)(void);
     void (*updateGamepadGUID)(char*);
+    GLFWbool (*getGamepadSnapshot)(int,GLFWgamepadstate*);
     // monitor
     void (*freeMonitor)(_GLFWmonitor*);
     void (*getMonitorPos)(_GLFWmonitor*,int*,int*);
@@ -732,12 +775,16 @@ struct _GLFWplatform
     GLFWbool (*windowMaximized)(_GLFWwindow*);
     GLFWbool (*windowHovered)(_GLFWwindow*);
     GLFWbool (*framebufferTransparent)(_GLFWwindow*);
+    GLFWbool (*windowAsyncPresentation)(_GLFWwindow*);
     float (*getWindowOpacity)(_GLFWwindow*);
     void (*setWindowResizable)(_GLFWwindow*,GLFWbool);
     void (*setWindowDecorated)(_GLFWwindow*,GLFWbool);
     void (*setWindowFloating)(_GLFWwindow*,GLFWbool);
     void (*setWindowOpacity)(_GLFWwindow*,float);
     void (*setWindowMousePassthrough)(_GLFWwindow*,GLFWbool);
+    void (*setWindowAsyncPresentation)(_GLFWwindow*,GLFWbool);
+    void (*updateWindowEvents)(_GLFWwindow*);
+    GLFWbool (*windowReadyForFrame)(_GLFWwindow*);
     void (*pollEvents)(void);
     void (*waitEvents)(void);
     void (*waitEventsTimeout)(double);
@@ -780,6 +827,7 @@ struct _GLFWlibrary
     _GLFWjoystick       joysticks[GLFW_JOYSTICK_LAST + 1];
     _GLFWmapping*       mappings;
     int                 mappingCount;
+    int                 mappingCapacity;
 
     _GLFWtls            errorSlot;
     _GLFWtls            contextSlot;
@@ -866,6 +914,9 @@ struct _GLFWlibrary
     struct {
         GLFWmonitorfun  monitor;
         GLFWjoystickfun joystick;
+        GLFWjoystickaxisfun joystickAxis;
+        GLFWjoystickbuttonfun joystickButton;
+        GLFWclipboardfun clipboard;
     } callbacks;
 
     // These are defined in platform.h
@@ -901,6 +952,9 @@ void* _glfwPlatformLoadModule(const char* path);
 void _glfwPlatformFreeModule(void* module);
 GLFWproc _glfwPlatformGetModuleSymbol(void* module, const char* name);
 
+GLFWbool _glfwPlatformMapFile(const char* path, void** data, size_t* size);
+void _glfwPlatformUnmapFile(void* data, size_t size);
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -915,6 +969,8 @@ void _glfwInputWindowContentScale(_GLFWwindow* window,
 void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified);
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized);
 void _glfwInputWindowDamage(_GLFWwindow* window);
+void _glfwInputWindowPresent(_GLFWwindow* window,
+                             double time, double refresh, uint64_t sequence);
 void _glfwInputWindowCloseRequest(_GLFWwindow* window);
 void _glfwInputWindowMonitor(_GLFWwindow* window, _GLFWmonitor* monitor);
 
@@ -931,6 +987,7 @@ void _glfwInputJoystick(_GLFWjoystick* js, int event);
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
 void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value);
+void _glfwInputClipboardString(const char* string);
 
 void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement);
 void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window);
@@ -973,6 +1030,12 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int buttonCount,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
+void _glfwFreeJoystickArrays(void);
+void _glfwApplyGamepadMapping(const _GLFWmapping* mapping,
+                              const float* axes,
+                              const unsigned char* buttons,
+                              const unsigned char* hats,
+                              GLFWgamepadstate* state);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
 
 GLFWbool _glfwInitEGL(void);
@@ -1006,6 +1069,7 @@ int _glfw_max(int a, int b);
 float _glfw_fminf(float a, float b);
 float _glfw_fmaxf(float a, float b);
 
+void* _glfw_malloc(size_t size);
 void* _glfw_calloc(size_t count, size_t size);
 void* _glfw_realloc(void* pointer, size_t size);
 void _glfw_free(void* pointer);
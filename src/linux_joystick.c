@@ -27,6 +27,8 @@
 // It is fine to use C99 in this file because it will not be built with VS
 //========================================================================
 
+#define _GNU_SOURCE
+
 #include "internal.h"
 
 #if defined(GLFW_BUILD_LINUX_JOYSTICK)
@@ -35,8 +37,11 @@
 #include <sys/stat.h>
 #include <sys/inotify.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <errno.h>
 #include <dirent.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -47,13 +52,200 @@
 #define SYN_DROPPED 3
 #endif
 
+// Locks the joystick state shared with the reader thread, if it is running
+//
+static void lockJoysticks(void)
+{
+    if (_glfw.linjs.threaded)
+        pthread_mutex_lock(&_glfw.linjs.mutex);
+}
+
+// Unlocks the joystick state shared with the reader thread, if it is running
+//
+static void unlockJoysticks(void)
+{
+    if (_glfw.linjs.threaded)
+        pthread_mutex_unlock(&_glfw.linjs.mutex);
+}
+
+// Writes a byte to the specified pipe, ignoring whether it is full
+//
+static void writePipe(int fd)
+{
+    for (;;)
+    {
+        const char byte = 0;
+        const ssize_t result = write(fd, &byte, 1);
+        if (result == 1 || (result == -1 && errno != EINTR))
+            break;
+    }
+}
+
+// Drains available data from the specified pipe
+//
+static void drainPipe(int fd)
+{
+    for (;;)
+    {
+        char dummy[64];
+        const ssize_t result = read(fd, dummy, sizeof(dummy));
+        if (result == -1 && errno != EINTR)
+            break;
+    }
+}
+
+// Makes the reader thread pick up changes to the set of open joysticks
+//
+static void wakeReaderThread(void)
+{
+    if (_glfw.linjs.threaded)
+        writePipe(_glfw.linjs.wakeup[1]);
+}
+
+// Publishes the current state of the specified joystick to other threads
+// The joystick state must be locked by the caller
+//
+static void publishState(_GLFWjoystick* js)
+{
+    _GLFWsnapshotLinux* snapshot = _glfw.linjs.snapshots + (js - _glfw.joysticks);
+    const unsigned int sequence = snapshot->sequence;
+
+    __atomic_store_n(&snapshot->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    snapshot->connected = js->linjs.active;
+    snapshot->mapped = js->linjs.active && js->linjs.mapped;
+
+    if (js->linjs.active)
+    {
+        _GLFWjoystickStateLinux* published = &js->linjs.published;
+
+        published->time = js->linjs.state.time;
+        memcpy(published->hats, js->linjs.state.hats, sizeof(published->hats));
+        if (js->axisCount)
+            memcpy(published->axes, js->linjs.state.axes, js->axisCount * sizeof(float));
+        if (js->buttonCount)
+            memcpy(published->buttons, js->linjs.state.buttons, js->buttonCount);
+    }
+
+    if (snapshot->mapped)
+    {
+        _glfwApplyGamepadMapping(js->linjs.mapping,
+                                 js->linjs.state.axes,
+                                 js->linjs.state.buttons,
+                                 js->linjs.state.hats,
+                                 &snapshot->gamepad);
+    }
+
+    __atomic_store_n(&snapshot->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+// Reads the most recently published raw state of the specified joystick
+// The result arrays must be large enough for the axes and buttons of the joystick
+//
+static void readPublishedState(const _GLFWjoystick* js,
+                               _GLFWjoystickStateLinux* result)
+{
+    const _GLFWsnapshotLinux* snapshot = _glfw.linjs.snapshots + (js - _glfw.joysticks);
+    const _GLFWjoystickStateLinux* published = &js->linjs.published;
+
+    for (;;)
+    {
+        const unsigned int sequence =
+            __atomic_load_n(&snapshot->sequence, __ATOMIC_ACQUIRE);
+        if (sequence & 1)
+            continue;
+
+        result->time = published->time;
+        memcpy(result->hats, published->hats, sizeof(result->hats));
+        if (js->axisCount)
+            memcpy(result->axes, published->axes, js->axisCount * sizeof(float));
+        if (js->buttonCount)
+            memcpy(result->buttons, published->buttons, js->buttonCount);
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&snapshot->sequence, __ATOMIC_RELAXED) == sequence)
+            break;
+    }
+}
+
+// Updates the reader thread copy of the gamepad mapping of the specified joystick
+//
+static void updateReaderMapping(_GLFWjoystick* js)
+{
+    // The shared mapping may be replaced by glfwUpdateGamepadMappings at any time
+    const GLFWbool mapped = js->mapping != NULL;
+    if (mapped == js->linjs.mapped)
+    {
+        if (!mapped || memcmp(js->mapping, js->linjs.mapping, sizeof(_GLFWmapping)) == 0)
+            return;
+    }
+
+    lockJoysticks();
+
+    if (mapped)
+        memcpy(js->linjs.mapping, js->mapping, sizeof(_GLFWmapping));
+
+    js->linjs.mapped = mapped;
+    publishState(js);
+
+    unlockJoysticks();
+}
+
+// Reports a new axis value, either directly or to the reader thread state
+//
+static void inputAxis(_GLFWjoystick* js, int axis, float value)
+{
+    if (_glfw.linjs.threaded)
+        js->linjs.state.axes[axis] = value;
+    else
+        _glfwInputJoystickAxis(js, axis, value);
+}
+
+// Reports a new button state, either directly or to the reader thread state
+//
+static void inputButton(_GLFWjoystick* js, int button, char value)
+{
+    if (_glfw.linjs.threaded)
+        js->linjs.state.buttons[button] = value;
+    else
+        _glfwInputJoystickButton(js, button, value);
+}
+
+// Reports a new hat state, either directly or to the reader thread state
+//
+static void inputHat(_GLFWjoystick* js, int hat, char value)
+{
+    if (_glfw.linjs.threaded)
+        js->linjs.state.hats[hat] = value;
+    else
+        _glfwInputJoystickHat(js, hat, value);
+}
+
 // Apply an EV_KEY event to the specified joystick
 //
 static void handleKeyEvent(_GLFWjoystick* js, int code, int value)
 {
-    _glfwInputJoystickButton(js,
-                             js->linjs.keyMap[code - BTN_MISC],
-                             value ? GLFW_PRESS : GLFW_RELEASE);
+    int first = 0, last = js->buttonCount - 1;
+
+    // The key codes are sorted, as they were found by scanning the key bits
+    while (first <= last)
+    {
+        const int button = (first + last) / 2;
+        const int buttonCode = js->linjs.keyCodes[button];
+
+        if (buttonCode == code)
+        {
+            inputButton(js, button, value ? GLFW_PRESS : GLFW_RELEASE);
+            return;
+        }
+
+        if (buttonCode < code)
+            first = button + 1;
+        else
+            last = button - 1;
+    }
 }
 
 // Apply an EV_ABS event to the specified joystick
@@ -84,11 +276,11 @@ static void handleAbsEvent(_GLFWjoystick* js, int code, int value)
         else if (value > 0)
             state[axis] = 2;
 
-        _glfwInputJoystickHat(js, index, stateMap[state[0]][state[1]]);
+        inputHat(js, index, stateMap[state[0]][state[1]]);
     }
     else
     {
-        const struct input_absinfo* info = &js->linjs.absInfo[code];
+        const struct input_absinfo* info = &js->linjs.absInfo[index];
         float normalized = value;
 
         const int range = info->maximum - info->minimum;
@@ -100,7 +292,7 @@ static void handleAbsEvent(_GLFWjoystick* js, int code, int value)
             normalized = normalized * 2.0f - 1.0f;
         }
 
-        _glfwInputJoystickAxis(js, index, normalized);
+        inputAxis(js, index, normalized);
     }
 }
 
@@ -110,10 +302,15 @@ static void pollAbsState(_GLFWjoystick* js)
 {
     for (int code = 0;  code < ABS_CNT;  code++)
     {
-        if (js->linjs.absMap[code] < 0)
+        const int index = js->linjs.absMap[code];
+        if (index < 0)
             continue;
 
-        struct input_absinfo* info = &js->linjs.absInfo[code];
+        struct input_absinfo hatInfo;
+        struct input_absinfo* info = &hatInfo;
+
+        if (code < ABS_HAT0X || code > ABS_HAT3Y)
+            info = &js->linjs.absInfo[index];
 
         if (ioctl(js->linjs.fd, EVIOCGABS(code), info) < 0)
             continue;
@@ -122,12 +319,113 @@ static void pollAbsState(_GLFWjoystick* js)
     }
 }
 
+// Allocates the tables of the specified joystick, sized to its axes and buttons
+//
+static GLFWbool allocateTables(_GLFWjoystickLinux* linjs,
+                               const char* path,
+                               int axisCount,
+                               int buttonCount)
+{
+    // The reader thread has a working and a published copy of the raw state
+    const size_t stateCount = _glfw.linjs.threaded ? 2 : 0;
+    const size_t size = axisCount * sizeof(struct input_absinfo) +
+                        axisCount * stateCount * sizeof(float) +
+                        buttonCount * sizeof(unsigned short) +
+                        buttonCount * stateCount +
+                        strlen(path) + 1;
+
+    char* block = _glfw_calloc(1, size);
+    if (!block)
+        return GLFW_FALSE;
+
+    // Keep the most strictly aligned tables first
+    linjs->absInfo = (struct input_absinfo*) block;
+    block += axisCount * sizeof(struct input_absinfo);
+
+    if (stateCount)
+    {
+        linjs->state.axes = (float*) block;
+        block += axisCount * sizeof(float);
+        linjs->published.axes = (float*) block;
+        block += axisCount * sizeof(float);
+    }
+
+    linjs->keyCodes = (unsigned short*) block;
+    block += buttonCount * sizeof(unsigned short);
+
+    if (stateCount)
+    {
+        linjs->state.buttons = (unsigned char*) block;
+        block += buttonCount;
+        linjs->published.buttons = (unsigned char*) block;
+        block += buttonCount;
+    }
+
+    linjs->path = block;
+    strcpy(linjs->path, path);
+    return GLFW_TRUE;
+}
+
+// Returns the number of the specified event device node name, or -1 if the name
+// is not of the form eventN
+//
+static int parseEventNumber(const char* name)
+{
+    if (strncmp(name, "event", 5) != 0 || name[5] == '\0')
+        return -1;
+
+    int number = 0;
+
+    for (const char* c = name + 5;  *c;  c++)
+    {
+        if (*c < '0' || *c > '9' || number > (INT_MAX - 9) / 10)
+            return -1;
+
+        number = number * 10 + (*c - '0');
+    }
+
+    return number;
+}
+
+// Checks the capabilities of the specified event device via sysfs, without
+// opening the device node
+// Returns GLFW_FALSE only if the device is known not to be a joystick
+//
+static GLFWbool mayBeJoystick(int number)
+{
+    char path[64];
+    snprintf(path, sizeof(path),
+             "/sys/class/input/event%i/device/capabilities/ev", number);
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return GLFW_TRUE;
+
+    char buffer[64];
+    const ssize_t size = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+
+    if (size <= 0)
+        return GLFW_TRUE;
+
+    buffer[size] = '\0';
+
+    // The bitmask is printed as hexadecimal words, most significant first, and
+    // all event types fit in the last word
+    const char* word = strrchr(buffer, ' ');
+    const unsigned long bits = strtoul(word ? word + 1 : buffer, NULL, 16);
+    return (bits & (1ul << EV_ABS)) != 0;
+}
+
 #define isBitSet(bit, arr) (arr[(bit) / 8] & (1 << ((bit) % 8)))
 
 // Attempt to open the specified joystick device
 //
-static GLFWbool openJoystickDevice(const char* path)
+static GLFWbool openJoystickDevice(int number)
 {
+    char path[32];
+    snprintf(path, sizeof(path), "/dev/input/event%i", number);
+
     for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
         if (!_glfw.joysticks[jid].connected)
@@ -136,6 +434,9 @@ static GLFWbool openJoystickDevice(const char* path)
             return GLFW_FALSE;
     }
 
+    if (!mayBeJoystick(number))
+        return GLFW_FALSE;
+
     _GLFWjoystickLinux linjs = {0};
     linjs.fd = open(path, O_RDONLY | O_NONBLOCK);
     if (linjs.fd == -1)
@@ -191,32 +492,34 @@ static GLFWbool openJoystickDevice(const char* path)
     }
 
     int axisCount = 0, buttonCount = 0, hatCount = 0;
+    struct input_absinfo absInfo[ABS_CNT];
 
     for (int code = BTN_MISC;  code < KEY_CNT;  code++)
     {
-        if (!isBitSet(code, keyBits))
-            continue;
-
-        linjs.keyMap[code - BTN_MISC] = buttonCount;
-        buttonCount++;
+        if (isBitSet(code, keyBits))
+            buttonCount++;
     }
 
+    memset(linjs.absMap, -1, sizeof(linjs.absMap));
+
     for (int code = 0;  code < ABS_CNT;  code++)
     {
-        linjs.absMap[code] = -1;
         if (!isBitSet(code, absBits))
             continue;
 
         if (code >= ABS_HAT0X && code <= ABS_HAT3Y)
         {
-            linjs.absMap[code] = hatCount;
-            hatCount++;
-            // Skip the Y axis
-            code++;
+            // Both axes of a hat map to the same hat index
+            const int x = code - (code - ABS_HAT0X) % 2;
+            if (linjs.absMap[x] < 0)
+            {
+                linjs.absMap[x] = linjs.absMap[x + 1] = hatCount;
+                hatCount++;
+            }
         }
         else
         {
-            if (ioctl(linjs.fd, EVIOCGABS(code), &linjs.absInfo[code]) < 0)
+            if (ioctl(linjs.fd, EVIOCGABS(code), &absInfo[axisCount]) < 0)
                 continue;
 
             linjs.absMap[code] = axisCount;
@@ -224,19 +527,70 @@ static GLFWbool openJoystickDevice(const char* path)
         }
     }
 
+    if (!allocateTables(&linjs, path, axisCount, buttonCount))
+    {
+        close(linjs.fd);
+        return GLFW_FALSE;
+    }
+
+    if (axisCount)
+        memcpy(linjs.absInfo, absInfo, axisCount * sizeof(struct input_absinfo));
+
+    for (int code = BTN_MISC, button = 0;  code < KEY_CNT;  code++)
+    {
+        if (isBitSet(code, keyBits))
+            linjs.keyCodes[button++] = code;
+    }
+
+    // Have the kernel timestamp events with the clock used by the GLFW timer
+    int clock = (int) _glfw.timer.posix.clock;
+    linjs.timestamps = ioctl(linjs.fd, EVIOCSCLOCKID, &clock) == 0;
+
+    linjs.active = GLFW_TRUE;
+
+    // The reader thread applies its own copy of the gamepad mapping
+    if (_glfw.linjs.threaded)
+    {
+        linjs.mapping = _glfw_calloc(1, sizeof(_GLFWmapping));
+        if (!linjs.mapping)
+        {
+            _glfw_free(linjs.absInfo);
+            close(linjs.fd);
+            return GLFW_FALSE;
+        }
+    }
+
+    lockJoysticks();
+
     _GLFWjoystick* js =
         _glfwAllocJoystick(name, guid, axisCount, buttonCount, hatCount);
     if (!js)
     {
+        unlockJoysticks();
+        _glfw_free(linjs.mapping);
+        _glfw_free(linjs.absInfo);
         close(linjs.fd);
         return GLFW_FALSE;
     }
 
-    strncpy(linjs.path, path, sizeof(linjs.path) - 1);
     memcpy(&js->linjs, &linjs, sizeof(linjs));
 
     pollAbsState(js);
 
+    if (_glfw.linjs.threaded)
+    {
+        if (js->mapping)
+        {
+            memcpy(js->linjs.mapping, js->mapping, sizeof(_GLFWmapping));
+            js->linjs.mapped = GLFW_TRUE;
+        }
+
+        publishState(js);
+    }
+
+    unlockJoysticks();
+    wakeReaderThread();
+
     _glfwInputJoystick(js, GLFW_CONNECTED);
     return GLFW_TRUE;
 }
@@ -248,17 +602,265 @@ static GLFWbool openJoystickDevice(const char* path)
 static void closeJoystick(_GLFWjoystick* js)
 {
     _glfwInputJoystick(js, GLFW_DISCONNECTED);
+
+    lockJoysticks();
+
+    js->linjs.active = GLFW_FALSE;
+    if (_glfw.linjs.threaded)
+        publishState(js);
+
     close(js->linjs.fd);
+    // The tables are allocated as one block starting with absInfo
+    _glfw_free(js->linjs.absInfo);
+    _glfw_free(js->linjs.mapping);
     _glfwFreeJoystick(js);
+
+    unlockJoysticks();
+    wakeReaderThread();
+}
+
+// Compare event device numbers; used by qsort
+//
+static int compareDeviceNumbers(const void* fp, const void* sp)
+{
+    const int f = *((const int*) fp);
+    const int s = *((const int*) sp);
+    return (f > s) - (f < s);
+}
+
+
+// Reads all queued events of the specified joystick (non-blocking)
+// Returns whether any input report was completed
+//
+static GLFWbool readJoystickEvents(_GLFWjoystick* js)
+{
+    GLFWbool reported = GLFW_FALSE;
+
+    for (;;)
+    {
+        struct input_event e;
+
+        errno = 0;
+        if (read(js->linjs.fd, &e, sizeof(e)) < 0)
+        {
+            if (errno == ENODEV)
+            {
+                // Leave closing the joystick slot to the main thread
+                if (_glfw.linjs.threaded)
+                    __atomic_store_n(&js->linjs.lost, GLFW_TRUE, __ATOMIC_RELEASE);
+                else
+                    closeJoystick(js);
+
+                reported = GLFW_TRUE;
+            }
+
+            break;
+        }
+
+        if (js->linjs.timestamps)
+        {
+            const uint64_t time = (uint64_t) e.input_event_sec * 1000000000 +
+                                  (uint64_t) e.input_event_usec * 1000;
+
+            if (_glfw.linjs.threaded)
+                js->linjs.state.time = time;
+            else
+                js->inputTime = time;
+        }
+
+        if (e.type == EV_SYN)
+        {
+            if (e.code == SYN_DROPPED)
+                _glfw.linjs.dropped = GLFW_TRUE;
+            else if (e.code == SYN_REPORT)
+            {
+                _glfw.linjs.dropped = GLFW_FALSE;
+                pollAbsState(js);
+
+                if (_glfw.linjs.threaded)
+                    publishState(js);
+
+                reported = GLFW_TRUE;
+            }
+        }
+
+        if (_glfw.linjs.dropped)
+            continue;
+
+        if (e.type == EV_KEY)
+            handleKeyEvent(js, e.code, e.value);
+        else if (e.type == EV_ABS)
+            handleAbsEvent(js, e.code, e.value);
+    }
+
+    if (!_glfw.linjs.threaded)
+        js->inputTime = 0;
+
+    return reported;
 }
 
-// Lexically compare joysticks by name; used by qsort
+// Applies the state published by the reader thread to the specified joystick
 //
-static int compareJoysticks(const void* fp, const void* sp)
+static GLFWbool pollSnapshot(_GLFWjoystick* js)
 {
-    const _GLFWjoystick* fj = fp;
-    const _GLFWjoystick* sj = sp;
-    return strcmp(fj->linjs.path, sj->linjs.path);
+    if (__atomic_load_n(&js->linjs.lost, __ATOMIC_ACQUIRE))
+    {
+        closeJoystick(js);
+        return GLFW_FALSE;
+    }
+
+    updateReaderMapping(js);
+
+    float axes[ABS_CNT];
+    unsigned char buttons[KEY_CNT - BTN_MISC];
+    _GLFWjoystickStateLinux state = { 0, axes, buttons };
+    readPublishedState(js, &state);
+
+    js->inputTime = state.time;
+
+    for (int i = 0;  i < js->axisCount;  i++)
+        _glfwInputJoystickAxis(js, i, state.axes[i]);
+
+    for (int i = 0;  i < js->buttonCount;  i++)
+        _glfwInputJoystickButton(js, i, state.buttons[i]);
+
+    for (int i = 0;  i < js->hatCount;  i++)
+        _glfwInputJoystickHat(js, i, state.hats[i]);
+
+    js->inputTime = 0;
+    return js->connected;
+}
+
+// Entry point of the joystick reader thread
+//
+static void* readerThreadMain(void* arg)
+{
+    struct pollfd fds[1 + GLFW_JOYSTICK_LAST + 1];
+    int jids[GLFW_JOYSTICK_LAST + 1];
+
+    for (;;)
+    {
+        nfds_t count = 1;
+        fds[0] = (struct pollfd) { _glfw.linjs.wakeup[0], POLLIN };
+
+        pthread_mutex_lock(&_glfw.linjs.mutex);
+
+        for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        {
+            const _GLFWjoystickLinux* linjs = &_glfw.joysticks[jid].linjs;
+            if (linjs->active && !linjs->lost)
+            {
+                jids[count - 1] = jid;
+                fds[count++] = (struct pollfd) { linjs->fd, POLLIN };
+            }
+        }
+
+        pthread_mutex_unlock(&_glfw.linjs.mutex);
+
+        if (poll(fds, count, -1) == -1)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+
+            break;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            drainPipe(_glfw.linjs.wakeup[0]);
+            if (__atomic_load_n(&_glfw.linjs.quit, __ATOMIC_ACQUIRE))
+                break;
+        }
+
+        GLFWbool reported = GLFW_FALSE;
+
+        pthread_mutex_lock(&_glfw.linjs.mutex);
+
+        for (nfds_t i = 1;  i < count;  i++)
+        {
+            _GLFWjoystick* js = _glfw.joysticks + jids[i - 1];
+
+            if (!fds[i].revents)
+                continue;
+
+            // The joystick may have been closed while this thread was waiting
+            if (!js->linjs.active || js->linjs.fd != fds[i].fd)
+                continue;
+
+            if (readJoystickEvents(js))
+                reported = GLFW_TRUE;
+        }
+
+        pthread_mutex_unlock(&_glfw.linjs.mutex);
+
+        // Wake up the main thread if it is waiting for events
+        if (reported && !__atomic_exchange_n(&_glfw.linjs.notified, GLFW_TRUE,
+                                             __ATOMIC_ACQ_REL))
+        {
+            writePipe(_glfw.linjs.notify[1]);
+        }
+    }
+
+    return NULL;
+}
+
+// Starts the joystick reader thread
+//
+static void startReaderThread(void)
+{
+    if (pipe2(_glfw.linjs.wakeup, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to create joystick thread pipe: %s",
+                        strerror(errno));
+        return;
+    }
+
+    if (pipe2(_glfw.linjs.notify, O_NONBLOCK | O_CLOEXEC) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to create joystick thread pipe: %s",
+                        strerror(errno));
+        close(_glfw.linjs.wakeup[0]);
+        close(_glfw.linjs.wakeup[1]);
+        return;
+    }
+
+    pthread_mutex_init(&_glfw.linjs.mutex, NULL);
+
+    const int error = pthread_create(&_glfw.linjs.thread, NULL,
+                                     readerThreadMain, NULL);
+    if (error)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Linux: Failed to create joystick thread: %s",
+                        strerror(error));
+        pthread_mutex_destroy(&_glfw.linjs.mutex);
+        close(_glfw.linjs.wakeup[0]);
+        close(_glfw.linjs.wakeup[1]);
+        close(_glfw.linjs.notify[0]);
+        close(_glfw.linjs.notify[1]);
+        return;
+    }
+
+    _glfw.linjs.threaded = GLFW_TRUE;
+}
+
+// Stops the joystick reader thread
+//
+static void stopReaderThread(void)
+{
+    __atomic_store_n(&_glfw.linjs.quit, GLFW_TRUE, __ATOMIC_RELEASE);
+    writePipe(_glfw.linjs.wakeup[1]);
+    pthread_join(_glfw.linjs.thread, NULL);
+
+    _glfw.linjs.threaded = GLFW_FALSE;
+
+    pthread_mutex_destroy(&_glfw.linjs.mutex);
+    close(_glfw.linjs.wakeup[0]);
+    close(_glfw.linjs.wakeup[1]);
+    close(_glfw.linjs.notify[0]);
+    close(_glfw.linjs.notify[1]);
 }
 
 
@@ -277,23 +879,26 @@ void _glfwDetectJoystickConnectionLinux(void)
 
     while (size > offset)
     {
-        regmatch_t match;
         const struct inotify_event* e = (struct inotify_event*) (buffer + offset);
 
         offset += sizeof(struct inotify_event) + e->len;
 
-        if (regexec(&_glfw.linjs.regex, e->name, 1, &match, 0) != 0)
+        const int number = parseEventNumber(e->name);
+        if (number < 0)
             continue;
 
-        char path[PATH_MAX];
-        snprintf(path, sizeof(path), "/dev/input/%s", e->name);
-
         if (e->mask & (IN_CREATE | IN_ATTRIB))
-            openJoystickDevice(path);
+            openJoystickDevice(number);
         else if (e->mask & IN_DELETE)
         {
+            char path[32];
+            snprintf(path, sizeof(path), "/dev/input/event%i", number);
+
             for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
             {
+                if (!_glfw.joysticks[jid].connected)
+                    continue;
+
                 if (strcmp(_glfw.joysticks[jid].linjs.path, path) == 0)
                 {
                     closeJoystick(_glfw.joysticks + jid);
@@ -309,6 +914,78 @@ void _glfwDetectJoystickConnectionLinux(void)
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+// Fills the specified array with the device connection notification and
+// joystick device descriptors and returns their number
+// The array must have room for GLFW_JOYSTICK_LAST + 2 elements
+//
+int _glfwGetJoystickPollFdsLinux(struct pollfd* fds)
+{
+    int count = 0;
+
+    if (_glfw.linjs.inotify > 0)
+        fds[count++] = (struct pollfd) { _glfw.linjs.inotify, POLLIN };
+
+    // The reader thread owns the joystick descriptors when it is running
+    if (_glfw.linjs.threaded)
+    {
+        fds[count++] = (struct pollfd) { _glfw.linjs.notify[0], POLLIN };
+        return count;
+    }
+
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (_glfw.joysticks[jid].connected)
+            fds[count++] = (struct pollfd) { _glfw.joysticks[jid].linjs.fd, POLLIN };
+    }
+
+    return count;
+}
+
+// Drains pending events of all connected joysticks
+//
+void _glfwPollJoysticksLinux(void)
+{
+    if (_glfw.linjs.threaded)
+    {
+        __atomic_store_n(&_glfw.linjs.notified, GLFW_FALSE, __ATOMIC_RELEASE);
+        drainPipe(_glfw.linjs.notify[0]);
+
+        for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        {
+            if (_glfw.joysticks[jid].connected)
+                pollSnapshot(_glfw.joysticks + jid);
+        }
+
+        return;
+    }
+
+    struct pollfd fds[GLFW_JOYSTICK_LAST + 1];
+    int jids[GLFW_JOYSTICK_LAST + 1];
+    nfds_t count = 0;
+
+    for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (_glfw.joysticks[jid].connected)
+        {
+            fds[count] = (struct pollfd) { _glfw.joysticks[jid].linjs.fd, POLLIN };
+            jids[count++] = jid;
+        }
+    }
+
+    if (!count)
+        return;
+
+    // Only read from devices with pending events, including disconnection
+    // If polling fails, read from every device instead
+    const GLFWbool polled = poll(fds, count, 0) != -1;
+
+    for (nfds_t i = 0;  i < count;  i++)
+    {
+        if (!polled || fds[i].revents)
+            readJoystickEvents(_glfw.joysticks + jids[i]);
+    }
+}
+
 GLFWbool _glfwInitJoysticksLinux(void)
 {
     const char* dirname = "/dev/input";
@@ -326,13 +1003,11 @@ GLFWbool _glfwInitJoysticksLinux(void)
 
     // Continue without device connection notifications if inotify fails
 
-    if (regcomp(&_glfw.linjs.regex, "^event[0-9]\\+$", 0) != 0)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR, "Linux: Failed to compile regex");
-        return GLFW_FALSE;
-    }
+    if (_glfw.hints.init.joystickThread)
+        startReaderThread();
 
-    int count = 0;
+    int* numbers = NULL;
+    int count = 0, capacity = 0;
 
     DIR* dir = opendir(dirname);
     if (dir)
@@ -341,17 +1016,21 @@ GLFWbool _glfwInitJoysticksLinux(void)
 
         while ((entry = readdir(dir)))
         {
-            regmatch_t match;
-
-            if (regexec(&_glfw.linjs.regex, entry->d_name, 1, &match, 0) != 0)
+            const int number = parseEventNumber(entry->d_name);
+            if (number < 0)
                 continue;
 
-            char path[PATH_MAX];
+            if (count == capacity)
+            {
+                capacity = capacity ? capacity * 2 : 32;
+                int* resized = _glfw_realloc(numbers, capacity * sizeof(int));
+                if (!resized)
+                    break;
 
-            snprintf(path, sizeof(path), "%s/%s", dirname, entry->d_name);
+                numbers = resized;
+            }
 
-            if (openJoystickDevice(path))
-                count++;
+            numbers[count++] = number;
         }
 
         closedir(dir);
@@ -359,12 +1038,22 @@ GLFWbool _glfwInitJoysticksLinux(void)
 
     // Continue with no joysticks if enumeration fails
 
-    qsort(_glfw.joysticks, count, sizeof(_GLFWjoystick), compareJoysticks);
+    // Open the devices in order so the joysticks are not moved between slots
+    if (count)
+        qsort(numbers, count, sizeof(int), compareDeviceNumbers);
+
+    for (int i = 0;  i < count;  i++)
+        openJoystickDevice(numbers[i]);
+
+    _glfw_free(numbers);
     return GLFW_TRUE;
 }
 
 void _glfwTerminateJoysticksLinux(void)
 {
+    if (_glfw.linjs.threaded)
+        stopReaderThread();
+
     for (int jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
         _GLFWjoystick* js = _glfw.joysticks + jid;
@@ -378,47 +1067,15 @@ void _glfwTerminateJoysticksLinux(void)
             inotify_rm_watch(_glfw.linjs.inotify, _glfw.linjs.watch);
 
         close(_glfw.linjs.inotify);
-        regfree(&_glfw.linjs.regex);
     }
 }
 
 GLFWbool _glfwPollJoystickLinux(_GLFWjoystick* js, int mode)
 {
-    // Read all queued events (non-blocking)
-    for (;;)
-    {
-        struct input_event e;
-
-        errno = 0;
-        if (read(js->linjs.fd, &e, sizeof(e)) < 0)
-        {
-            // Reset the joystick slot if the device was disconnected
-            if (errno == ENODEV)
-                closeJoystick(js);
-
-            break;
-        }
-
-        if (e.type == EV_SYN)
-        {
-            if (e.code == SYN_DROPPED)
-                _glfw.linjs.dropped = GLFW_TRUE;
-            else if (e.code == SYN_REPORT)
-            {
-                _glfw.linjs.dropped = GLFW_FALSE;
-                pollAbsState(js);
-            }
-        }
-
-        if (_glfw.linjs.dropped)
-            continue;
-
-        if (e.type == EV_KEY)
-            handleKeyEvent(js, e.code, e.value);
-        else if (e.type == EV_ABS)
-            handleAbsEvent(js, e.code, e.value);
-    }
+    if (_glfw.linjs.threaded)
+        return pollSnapshot(js);
 
+    readJoystickEvents(js);
     return js->connected;
 }
 
@@ -431,5 +1088,32 @@ void _glfwUpdateGamepadGUIDLinux(char* guid)
 {
 }
 
+GLFWbool _glfwGetGamepadSnapshotLinux(int jid, GLFWgamepadstate* state)
+{
+    if (!_glfw.linjs.threaded)
+        return GLFW_FALSE;
+
+    const _GLFWsnapshotLinux* snapshot = _glfw.linjs.snapshots + jid;
+    GLFWbool mapped;
+
+    // Only the gamepad part of the snapshot is copied
+    for (;;)
+    {
+        const unsigned int sequence =
+            __atomic_load_n(&snapshot->sequence, __ATOMIC_ACQUIRE);
+        if (sequence & 1)
+            continue;
+
+        mapped = snapshot->mapped;
+        *state = snapshot->gamepad;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&snapshot->sequence, __ATOMIC_RELAXED) == sequence)
+            break;
+    }
+
+    return mapped;
+}
+
 #endif // GLFW_BUILD_LINUX_JOYSTICK
 
@@ -25,22 +25,63 @@
 //========================================================================
 
 #include <linux/input.h>
-#include <linux/limits.h>
-#include <regex.h>
+#include <poll.h>
+#include <pthread.h>
+
+// Older kernel headers lack the Y2038-safe aliases for the event timestamp
+#if !defined(input_event_sec)
+ #define input_event_sec time.tv_sec
+ #define input_event_usec time.tv_usec
+#endif
 
 #define GLFW_LINUX_JOYSTICK_STATE         _GLFWjoystickLinux linjs;
 #define GLFW_LINUX_LIBRARY_JOYSTICK_STATE _GLFWlibraryLinux  linjs;
 
+// Raw joystick state gathered by the reader thread
+//
+typedef struct _GLFWjoystickStateLinux
+{
+    uint64_t                time;
+    float*                  axes;
+    unsigned char*          buttons;
+    unsigned char           hats[4];
+} _GLFWjoystickStateLinux;
+
+// Joystick state published by the reader thread, guarded by a sequence lock
+// The raw state is kept by the joystick, as only the main thread reads it
+//
+typedef struct _GLFWsnapshotLinux
+{
+    unsigned int            sequence;
+    GLFWbool                connected;
+    GLFWbool                mapped;
+    GLFWgamepadstate        gamepad;
+} _GLFWsnapshotLinux;
+
 // Linux-specific joystick data
 //
 typedef struct _GLFWjoystickLinux
 {
     int                     fd;
-    char                    path[PATH_MAX];
-    int                     keyMap[KEY_CNT - BTN_MISC];
-    int                     absMap[ABS_CNT];
-    struct input_absinfo    absInfo[ABS_CNT];
+    // The tables below are sized to the device and allocated as one block,
+    // starting with absInfo
+    char*                   path;
+    // Key codes of the buttons in ascending order, indexed by button
+    unsigned short*         keyCodes;
+    // Ranges of the absolute axes, indexed by axis
+    struct input_absinfo*   absInfo;
+    // Axis or hat index of each absolute axis code, or -1 if not present
+    signed char             absMap[ABS_CNT];
     int                     hats[4][2];
+    GLFWbool                timestamps;
+    // These are shared with the reader thread and guarded by its mutex
+    GLFWbool                active;
+    GLFWbool                lost;
+    GLFWbool                mapped;
+    _GLFWmapping*           mapping;
+    _GLFWjoystickStateLinux state;
+    // This is guarded by the sequence lock of the snapshot
+    _GLFWjoystickStateLinux published;
 } _GLFWjoystickLinux;
 
 // Linux-specific joystick API data
@@ -49,15 +90,25 @@ typedef struct _GLFWlibraryLinux
 {
     int                     inotify;
     int                     watch;
-    regex_t                 regex;
     GLFWbool                dropped;
+    GLFWbool                threaded;
+    pthread_t               thread;
+    pthread_mutex_t         mutex;
+    int                     wakeup[2];
+    int                     notify[2];
+    GLFWbool                notified;
+    GLFWbool                quit;
+    _GLFWsnapshotLinux      snapshots[GLFW_JOYSTICK_LAST + 1];
 } _GLFWlibraryLinux;
 
 void _glfwDetectJoystickConnectionLinux(void);
+int _glfwGetJoystickPollFdsLinux(struct pollfd* fds);
+void _glfwPollJoysticksLinux(void);
 
 GLFWbool _glfwInitJoysticksLinux(void);
 void _glfwTerminateJoysticksLinux(void);
 GLFWbool _glfwPollJoystickLinux(_GLFWjoystick* js, int mode);
 const char* _glfwGetMappingNameLinux(void);
 void _glfwUpdateGamepadGUIDLinux(char* guid);
+GLFWbool _glfwGetGamepadSnapshotLinux(int jid, GLFWgamepadstate* state);
 
@@ -56,11 +56,14 @@ GLFWbool _glfwConnectNull(int platformID, _GLFWplatform* platform)
         _glfwGetKeyScancodeNull,
         _glfwSetClipboardStringNull,
         _glfwGetClipboardStringNull,
+        _glfwRequestClipboardStringNull,
         _glfwInitJoysticksNull,
         _glfwTerminateJoysticksNull,
         _glfwPollJoystickNull,
+        _glfwPollJoysticksNull,
         _glfwGetMappingNameNull,
         _glfwUpdateGamepadGUIDNull,
+        _glfwGetGamepadSnapshotNull,
         _glfwFreeMonitorNull,
         _glfwGetMonitorPosNull,
         _glfwGetMonitorContentScaleNull,
@@ -96,12 +99,16 @@ GLFWbool _glfwConnectNull(int platformID, _GLFWplatform* platform)
         _glfwWindowMaximizedNull,
         _glfwWindowHoveredNull,
         _glfwFramebufferTransparentNull,
+        _glfwWindowAsyncPresentationNull,
         _glfwGetWindowOpacityNull,
         _glfwSetWindowResizableNull,
         _glfwSetWindowDecoratedNull,
         _glfwSetWindowFloatingNull,
         _glfwSetWindowOpacityNull,
         _glfwSetWindowMousePassthroughNull,
+        _glfwSetWindowAsyncPresentationNull,
+        _glfwUpdateWindowEventsNull,
+        _glfwWindowReadyForFrameNull,
         _glfwPollEventsNull,
         _glfwWaitEventsNull,
         _glfwWaitEventsTimeoutNull,
@@ -28,6 +28,47 @@
 
 #include "internal.h"
 
+#include <assert.h>
+#include <string.h>
+
+
+// Disconnects the specified virtual joystick
+//
+static void closeJoystick(_GLFWjoystick* js)
+{
+    _glfwInputJoystick(js, GLFW_DISCONNECTED);
+    _glfwFreeJoystick(js);
+}
+
+// Returns the specified virtual joystick, or NULL if the Null platform is not
+// active or the joystick is not present
+//
+static _GLFWjoystick* getVirtualJoystick(int jid)
+{
+    _GLFWjoystick* js;
+
+    if (_glfw.platform.platformID != GLFW_PLATFORM_NULL)
+    {
+        _glfwInputError(GLFW_PLATFORM_UNAVAILABLE, "Null: Platform not initialized");
+        return NULL;
+    }
+
+    if (jid < 0 || jid > GLFW_JOYSTICK_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick ID %i", jid);
+        return NULL;
+    }
+
+    js = _glfw.joysticks + jid;
+    if (!js->connected)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Null: Joystick %i is not present", jid);
+        return NULL;
+    }
+
+    return js;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -40,11 +81,23 @@ GLFWbool _glfwInitJoysticksNull(void)
 
 void _glfwTerminateJoysticksNull(void)
 {
+    int jid;
+
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (_glfw.joysticks[jid].connected)
+            closeJoystick(_glfw.joysticks + jid);
+    }
 }
 
 GLFWbool _glfwPollJoystickNull(_GLFWjoystick* js, int mode)
 {
-    return GLFW_FALSE;
+    // Virtual joystick state is reported as it is set
+    return js->connected;
+}
+
+void _glfwPollJoysticksNull(void)
+{
 }
 
 const char* _glfwGetMappingNameNull(void)
@@ -56,3 +109,154 @@ void _glfwUpdateGamepadGUIDNull(char* guid)
 {
 }
 
+GLFWbool _glfwGetGamepadSnapshotNull(int jid, GLFWgamepadstate* state)
+{
+    return GLFW_FALSE;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI int glfwCreateNullJoystick(const char* name,
+                                   const char* guid,
+                                   int axisCount,
+                                   int buttonCount,
+                                   int hatCount)
+{
+    int i;
+    char lowercase[33];
+    _GLFWjoystick* js;
+
+    assert(name != NULL);
+    assert(guid != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(-1);
+
+    if (_glfw.platform.platformID != GLFW_PLATFORM_NULL)
+    {
+        _glfwInputError(GLFW_PLATFORM_UNAVAILABLE, "Null: Platform not initialized");
+        return -1;
+    }
+
+    if (axisCount < 0 || buttonCount < 0 || hatCount < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid joystick element counts %i, %i and %i",
+                        axisCount, buttonCount, hatCount);
+        return -1;
+    }
+
+    if (strlen(guid) != 32 || strspn(guid, "0123456789abcdefABCDEF") != 32)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid joystick GUID %s", guid);
+        return -1;
+    }
+
+    // Gamepad mappings are matched against lowercase GUIDs
+    for (i = 0;  i < 33;  i++)
+    {
+        if (guid[i] >= 'A' && guid[i] <= 'F')
+            lowercase[i] = guid[i] + 'a' - 'A';
+        else
+            lowercase[i] = guid[i];
+    }
+
+    js = _glfwAllocJoystick(name, lowercase, axisCount, buttonCount, hatCount);
+    if (!js)
+        return -1;
+
+    _glfwInputJoystick(js, GLFW_CONNECTED);
+    return (int) (js - _glfw.joysticks);
+}
+
+GLFWAPI void glfwDestroyNullJoystick(int jid)
+{
+    _GLFWjoystick* js;
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    closeJoystick(js);
+}
+
+GLFWAPI void glfwSetNullJoystickAxis(int jid, int axis, float value)
+{
+    _GLFWjoystick* js;
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    if (axis < 0 || axis >= js->axisCount)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid joystick axis %i", axis);
+        return;
+    }
+
+    if (!(value >= -1.f && value <= 1.f))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid joystick axis value %f", value);
+        return;
+    }
+
+    _glfwInputJoystickAxis(js, axis, value);
+}
+
+GLFWAPI void glfwSetNullJoystickButton(int jid, int button, int action)
+{
+    _GLFWjoystick* js;
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    if (button < 0 || button >= js->buttonCount)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid joystick button %i", button);
+        return;
+    }
+
+    if (action != GLFW_PRESS && action != GLFW_RELEASE)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid joystick button action %i", action);
+        return;
+    }
+
+    _glfwInputJoystickButton(js, button, (char) action);
+}
+
+GLFWAPI void glfwSetNullJoystickHat(int jid, int hat, int state)
+{
+    _GLFWjoystick* js;
+
+    _GLFW_REQUIRE_INIT();
+
+    js = getVirtualJoystick(jid);
+    if (!js)
+        return;
+
+    if (hat < 0 || hat >= js->hatCount)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid joystick hat %i", hat);
+        return;
+    }
+
+    // Valid hat states have at most two adjacent direction bits set
+    if ((state & ~0xf) || (state & ((state << 2) | (state >> 2))))
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid joystick hat state %i", state);
+        return;
+    }
+
+    _glfwInputJoystickHat(js, hat, (char) state);
+}
+
@@ -27,6 +27,8 @@
 GLFWbool _glfwInitJoysticksNull(void);
 void _glfwTerminateJoysticksNull(void);
 GLFWbool _glfwPollJoystickNull(_GLFWjoystick* js, int mode);
+void _glfwPollJoysticksNull(void);
 const char* _glfwGetMappingNameNull(void);
 void _glfwUpdateGamepadGUIDNull(char* guid);
+GLFWbool _glfwGetGamepadSnapshotNull(int jid, GLFWgamepadstate* state);
 
@@ -105,10 +105,14 @@ void _glfwMaximizeWindowNull(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedNull(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredNull(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentNull(_GLFWwindow* window);
+GLFWbool _glfwWindowAsyncPresentationNull(_GLFWwindow* window);
 void _glfwSetWindowResizableNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowFloatingNull(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowMousePassthroughNull(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowAsyncPresentationNull(_GLFWwindow* window, GLFWbool enabled);
+void _glfwUpdateWindowEventsNull(_GLFWwindow* window);
+GLFWbool _glfwWindowReadyForFrameNull(_GLFWwindow* window);
 float _glfwGetWindowOpacityNull(_GLFWwindow* window);
 void _glfwSetWindowOpacityNull(_GLFWwindow* window, float opacity);
 void _glfwSetRawMouseMotionNull(_GLFWwindow *window, GLFWbool enabled);
@@ -134,6 +138,7 @@ void _glfwDestroyCursorNull(_GLFWcursor* cursor);
 void _glfwSetCursorNull(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringNull(const char* string);
 const char* _glfwGetClipboardStringNull(void);
+void _glfwRequestClipboardStringNull(void);
 const char* _glfwGetScancodeNameNull(int scancode);
 int _glfwGetKeyScancodeNull(int key);
 
@@ -389,6 +389,11 @@ GLFWbool _glfwFramebufferTransparentNull(_GLFWwindow* window)
     return window->null.transparent;
 }
 
+GLFWbool _glfwWindowAsyncPresentationNull(_GLFWwindow* window)
+{
+    return GLFW_FALSE;
+}
+
 void _glfwSetWindowResizableNull(_GLFWwindow* window, GLFWbool enabled)
 {
     window->null.resizable = enabled;
@@ -408,6 +413,19 @@ void _glfwSetWindowMousePassthroughNull(_GLFWwindow* window, GLFWbool enabled)
 {
 }
 
+void _glfwSetWindowAsyncPresentationNull(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
+void _glfwUpdateWindowEventsNull(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwWindowReadyForFrameNull(_GLFWwindow* window)
+{
+    return GLFW_TRUE;
+}
+
 float _glfwGetWindowOpacityNull(_GLFWwindow* window)
 {
     return window->null.opacity;
@@ -551,6 +569,11 @@ const char* _glfwGetClipboardStringNull(void)
     return _glfw.null.clipboardString;
 }
 
+void _glfwRequestClipboardStringNull(void)
+{
+    _glfwInputClipboardString(_glfwGetClipboardStringNull());
+}
+
 EGLenum _glfwGetEGLPlatformNull(EGLint** attribs)
 {
     return 0;
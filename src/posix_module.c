@@ -31,6 +31,10 @@
 #if defined(GLFW_BUILD_POSIX_MODULE)
 
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -51,5 +55,47 @@ GLFWproc _glfwPlatformGetModuleSymbol(void* module, const char* name)
     return dlsym(module, name);
 }
 
+GLFWbool _glfwPlatformMapFile(const char* path, void** data, size_t* size)
+{
+    *data = NULL;
+    *size = 0;
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+        return GLFW_FALSE;
+
+    struct stat sb;
+    if (fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode))
+    {
+        close(fd);
+        return GLFW_FALSE;
+    }
+
+    // An empty file cannot be mapped but is still a valid file
+    if (sb.st_size == 0)
+    {
+        close(fd);
+        return GLFW_TRUE;
+    }
+
+    void* address = mmap(NULL, (size_t) sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (address == MAP_FAILED)
+        return GLFW_FALSE;
+
+    posix_madvise(address, (size_t) sb.st_size, POSIX_MADV_SEQUENTIAL);
+
+    *data = address;
+    *size = (size_t) sb.st_size;
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformUnmapFile(void* data, size_t size)
+{
+    if (data)
+        munmap(data, size);
+}
+
 #endif // GLFW_BUILD_POSIX_MODULE
 
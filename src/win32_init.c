@@ -621,11 +621,14 @@ GLFWbool _glfwConnectWin32(int platformID, _GLFWplatform* platform)
         _glfwGetKeyScancodeWin32,
         _glfwSetClipboardStringWin32,
         _glfwGetClipboardStringWin32,
+        _glfwRequestClipboardStringWin32,
         _glfwInitJoysticksWin32,
         _glfwTerminateJoysticksWin32,
         _glfwPollJoystickWin32,
+        _glfwPollJoysticksWin32,
         _glfwGetMappingNameWin32,
         _glfwUpdateGamepadGUIDWin32,
+        _glfwGetGamepadSnapshotWin32,
         _glfwFreeMonitorWin32,
         _glfwGetMonitorPosWin32,
         _glfwGetMonitorContentScaleWin32,
@@ -661,12 +664,16 @@ GLFWbool _glfwConnectWin32(int platformID, _GLFWplatform* platform)
         _glfwWindowMaximizedWin32,
         _glfwWindowHoveredWin32,
         _glfwFramebufferTransparentWin32,
+        _glfwWindowAsyncPresentationWin32,
         _glfwGetWindowOpacityWin32,
         _glfwSetWindowResizableWin32,
         _glfwSetWindowDecoratedWin32,
         _glfwSetWindowFloatingWin32,
         _glfwSetWindowOpacityWin32,
         _glfwSetWindowMousePassthroughWin32,
+        _glfwSetWindowAsyncPresentationWin32,
+        _glfwUpdateWindowEventsWin32,
+        _glfwWindowReadyForFrameWin32,
         _glfwPollEventsWin32,
         _glfwWaitEventsWin32,
         _glfwWaitEventsTimeoutWin32,
@@ -758,5 +758,21 @@ void _glfwUpdateGamepadGUIDWin32(char* guid)
     }
 }
 
+void _glfwPollJoysticksWin32(void)
+{
+    int jid;
+
+    for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+    {
+        if (_glfw.joysticks[jid].connected)
+            _glfwPollJoystickWin32(_glfw.joysticks + jid, _GLFW_POLL_ALL);
+    }
+}
+
+GLFWbool _glfwGetGamepadSnapshotWin32(int jid, GLFWgamepadstate* state)
+{
+    return GLFW_FALSE;
+}
+
 #endif // _GLFW_WIN32
 
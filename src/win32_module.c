@@ -49,5 +49,74 @@ GLFWproc _glfwPlatformGetModuleSymbol(void* module, const char* name)
     return (GLFWproc) GetProcAddress((HMODULE) module, name);
 }
 
+GLFWbool _glfwPlatformMapFile(const char* path, void** data, size_t* size)
+{
+    HANDLE file, mapping;
+    LARGE_INTEGER fileSize;
+    WCHAR* widePath;
+    int count;
+
+    *data = NULL;
+    *size = 0;
+
+    // This file is also built without the Win32 platform, so the path is
+    // converted here rather than with _glfwCreateWideStringFromUTF8Win32
+    count = MultiByteToWideChar(CP_UTF8, 0, path, -1, NULL, 0);
+    if (!count)
+        return GLFW_FALSE;
+
+    widePath = _glfw_calloc(count, sizeof(WCHAR));
+    if (!widePath)
+        return GLFW_FALSE;
+
+    if (!MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath, count))
+    {
+        _glfw_free(widePath);
+        return GLFW_FALSE;
+    }
+
+    file = CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                       OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    _glfw_free(widePath);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return GLFW_FALSE;
+
+    if (!GetFileSizeEx(file, &fileSize) ||
+        (ULONGLONG) fileSize.QuadPart > (size_t) -1)
+    {
+        CloseHandle(file);
+        return GLFW_FALSE;
+    }
+
+    // An empty file cannot be mapped but is still a valid file
+    if (fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return GLFW_TRUE;
+    }
+
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if (!mapping)
+        return GLFW_FALSE;
+
+    *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (!*data)
+        return GLFW_FALSE;
+
+    *size = (size_t) fileSize.QuadPart;
+    return GLFW_TRUE;
+}
+
+void _glfwPlatformUnmapFile(void* data, size_t size)
+{
+    if (data)
+        UnmapViewOfFile(data);
+}
+
 #endif // GLFW_BUILD_WIN32_MODULE
 
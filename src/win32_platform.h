@@ -566,10 +566,14 @@ GLFWbool _glfwWindowVisibleWin32(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedWin32(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredWin32(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentWin32(_GLFWwindow* window);
+GLFWbool _glfwWindowAsyncPresentationWin32(_GLFWwindow* window);
 void _glfwSetWindowResizableWin32(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedWin32(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowFloatingWin32(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowMousePassthroughWin32(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowAsyncPresentationWin32(_GLFWwindow* window, GLFWbool enabled);
+void _glfwUpdateWindowEventsWin32(_GLFWwindow* window);
+GLFWbool _glfwWindowReadyForFrameWin32(_GLFWwindow* window);
 float _glfwGetWindowOpacityWin32(_GLFWwindow* window);
 void _glfwSetWindowOpacityWin32(_GLFWwindow* window, float opacity);
 
@@ -592,6 +596,7 @@ void _glfwDestroyCursorWin32(_GLFWcursor* cursor);
 void _glfwSetCursorWin32(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringWin32(const char* string);
 const char* _glfwGetClipboardStringWin32(void);
+void _glfwRequestClipboardStringWin32(void);
 
 EGLenum _glfwGetEGLPlatformWin32(EGLint** attribs);
 EGLNativeDisplayType _glfwGetEGLNativeDisplayWin32(void);
@@ -613,8 +618,10 @@ void _glfwSetGammaRampWin32(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
 GLFWbool _glfwInitJoysticksWin32(void);
 void _glfwTerminateJoysticksWin32(void);
 GLFWbool _glfwPollJoystickWin32(_GLFWjoystick* js, int mode);
+void _glfwPollJoysticksWin32(void);
 const char* _glfwGetMappingNameWin32(void);
 void _glfwUpdateGamepadGUIDWin32(char* guid);
+GLFWbool _glfwGetGamepadSnapshotWin32(int jid, GLFWgamepadstate* state);
 
 GLFWbool _glfwInitWGL(void);
 void _glfwTerminateWGL(void);
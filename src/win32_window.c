@@ -1931,6 +1931,11 @@ GLFWbool _glfwFramebufferTransparentWin32(_GLFWwindow* window)
     return GLFW_TRUE;
 }
 
+GLFWbool _glfwWindowAsyncPresentationWin32(_GLFWwindow* window)
+{
+    return GLFW_FALSE;
+}
+
 void _glfwSetWindowResizableWin32(_GLFWwindow* window, GLFWbool enabled)
 {
     updateWindowStyles(window);
@@ -1978,6 +1983,19 @@ void _glfwSetWindowMousePassthroughWin32(_GLFWwindow* window, GLFWbool enabled)
         SetLayeredWindowAttributes(window->win32.handle, key, alpha, flags);
 }
 
+void _glfwSetWindowAsyncPresentationWin32(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
+void _glfwUpdateWindowEventsWin32(_GLFWwindow* window)
+{
+}
+
+GLFWbool _glfwWindowReadyForFrameWin32(_GLFWwindow* window)
+{
+    return GLFW_TRUE;
+}
+
 float _glfwGetWindowOpacityWin32(_GLFWwindow* window)
 {
     BYTE alpha;
@@ -2373,6 +2391,11 @@ const char* _glfwGetClipboardStringWin32(void)
     return _glfw.win32.clipboardString;
 }
 
+void _glfwRequestClipboardStringWin32(void)
+{
+    _glfwInputClipboardString(_glfwGetClipboardStringWin32());
+}
+
 EGLenum _glfwGetEGLPlatformWin32(EGLint** attribs)
 {
     if (_glfw.egl.ANGLE_platform_angle)
@@ -155,6 +155,18 @@ void _glfwInputWindowDamage(_GLFWwindow* window)
         window->callbacks.refresh((GLFWwindow*) window);
 }
 
+// Notifies shared code that a frame of the window has been presented
+//
+void _glfwInputWindowPresent(_GLFWwindow* window,
+                             double time, double refresh, uint64_t sequence)
+{
+    assert(window != NULL);
+    assert(refresh >= 0.0);
+
+    if (window->callbacks.present)
+        window->callbacks.present((GLFWwindow*) window, time, refresh, sequence);
+}
+
 // Notifies shared code that the user wishes to close a window
 //
 void _glfwInputWindowCloseRequest(_GLFWwindow* window)
@@ -397,6 +409,9 @@ GLFWAPI void glfwWindowHint(int hint, int value)
         case GLFW_MOUSE_PASSTHROUGH:
             _glfw.hints.window.mousePassthrough = value ? GLFW_TRUE : GLFW_FALSE;
             return;
+        case GLFW_ASYNC_PRESENTATION:
+            _glfw.hints.window.asyncPresentation = value ? GLFW_TRUE : GLFW_FALSE;
+            return;
         case GLFW_CLIENT_API:
             _glfw.hints.context.client = value;
             return;
@@ -870,6 +885,8 @@ GLFWAPI int glfwGetWindowAttrib(GLFWwindow* handle, int attrib)
             return window->mousePassthrough;
         case GLFW_TRANSPARENT_FRAMEBUFFER:
             return _glfw.platform.framebufferTransparent(window);
+        case GLFW_ASYNC_PRESENTATION:
+            return _glfw.platform.windowAsyncPresentation(window);
         case GLFW_RESIZABLE:
             return window->resizable;
         case GLFW_DECORATED:
@@ -949,6 +966,10 @@ GLFWAPI void glfwSetWindowAttrib(GLFWwindow* handle, int attrib, int value)
             window->mousePassthrough = value;
             _glfw.platform.setWindowMousePassthrough(window, value);
             return;
+
+        case GLFW_ASYNC_PRESENTATION:
+            _glfw.platform.setWindowAsyncPresentation(window, value);
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid window attribute 0x%08X", attrib);
@@ -1061,6 +1082,7 @@ GLFWAPI GLFWwindowrefreshfun glfwSetWindowRefreshCallback(GLFWwindow* handle,
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
     _GLFW_SWAP(GLFWwindowrefreshfun, window->callbacks.refresh, cbfun);
+    _glfw.platform.updateWindowEvents(window);
     return cbfun;
 }
 
@@ -1119,6 +1141,26 @@ GLFWAPI GLFWwindowcontentscalefun glfwSetWindowContentScaleCallback(GLFWwindow*
     return cbfun;
 }
 
+GLFWAPI GLFWwindowpresentfun glfwSetWindowPresentCallback(GLFWwindow* handle,
+                                                          GLFWwindowpresentfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP(GLFWwindowpresentfun, window->callbacks.present, cbfun);
+    return cbfun;
+}
+
+GLFWAPI int glfwWindowReadyForFrame(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+    return _glfw.platform.windowReadyForFrame(window);
+}
+
 GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
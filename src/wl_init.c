@@ -45,10 +45,23 @@
 #include "wayland-xdg-shell-client-protocol.h"
 #include "wayland-xdg-decoration-client-protocol.h"
 #include "wayland-viewporter-client-protocol.h"
+#include "wayland-presentation-time-client-protocol.h"
 #include "wayland-relative-pointer-unstable-v1-client-protocol.h"
 #include "wayland-pointer-constraints-unstable-v1-client-protocol.h"
 #include "wayland-idle-inhibit-unstable-v1-client-protocol.h"
 
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+#include "wayland-fractional-scale-v1-client-protocol.h"
+#endif
+
+#if defined(HAVE_TEARING_CONTROL_V1)
+#include "wayland-tearing-control-v1-client-protocol.h"
+#endif
+
+#if defined(HAVE_CURSOR_SHAPE_V1)
+#include "wayland-cursor-shape-v1-client-protocol.h"
+#endif
+
 // NOTE: Versions of wayland-scanner prior to 1.17.91 named every global array of
 //       wl_interface pointers 'types', making it impossible to combine several unmodified
 //       private-code files into a single compilation unit
@@ -70,6 +83,10 @@
 #include "wayland-viewporter-client-protocol-code.h"
 #undef types
 
+#define types _glfw_presentation_time_types
+#include "wayland-presentation-time-client-protocol-code.h"
+#undef types
+
 #define types _glfw_relative_pointer_types
 #include "wayland-relative-pointer-unstable-v1-client-protocol-code.h"
 #undef types
@@ -82,6 +99,40 @@
 #include "wayland-idle-inhibit-unstable-v1-client-protocol-code.h"
 #undef types
 
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+#define types _glfw_fractional_scale_types
+#include "wayland-fractional-scale-v1-client-protocol-code.h"
+#undef types
+#endif
+
+#if defined(HAVE_TEARING_CONTROL_V1)
+#define types _glfw_tearing_control_types
+#include "wayland-tearing-control-v1-client-protocol-code.h"
+#undef types
+#endif
+
+#if defined(HAVE_CURSOR_SHAPE_V1)
+#define types _glfw_tablet_types
+#include "wayland-tablet-unstable-v2-client-protocol-code.h"
+#undef types
+
+#define types _glfw_cursor_shape_types
+#include "wayland-cursor-shape-v1-client-protocol-code.h"
+#undef types
+#endif
+
+static void presentationHandleClockId(void* userData,
+                                      struct wp_presentation* presentation,
+                                      uint32_t clockId)
+{
+    _glfw.wl.presentationClock = clockId;
+}
+
+static const struct wp_presentation_listener presentationListener =
+{
+    presentationHandleClockId
+};
+
 static void wmBaseHandlePing(void* userData,
                              struct xdg_wm_base* wmBase,
                              uint32_t serial)
@@ -124,9 +175,15 @@ static void registryHandleGlobal(void* userData,
     {
         if (!_glfw.wl.seat)
         {
+            // Pointer frames need version 5 and high-resolution scrolling 8
+#if defined(WL_POINTER_AXIS_VALUE120_SINCE_VERSION)
+            const int maxVersion = WL_POINTER_AXIS_VALUE120_SINCE_VERSION;
+#else
+            const int maxVersion = WL_POINTER_FRAME_SINCE_VERSION;
+#endif
             _glfw.wl.seat =
                 wl_registry_bind(registry, name, &wl_seat_interface,
-                                 _glfw_min(4, version));
+                                 _glfw_min(maxVersion, version));
             _glfwAddSeatListenerWayland(_glfw.wl.seat);
         }
     }
@@ -157,6 +214,14 @@ static void registryHandleGlobal(void* userData,
         _glfw.wl.viewporter =
             wl_registry_bind(registry, name, &wp_viewporter_interface, 1);
     }
+    else if (strcmp(interface, "wp_presentation") == 0)
+    {
+        _glfw.wl.presentation =
+            wl_registry_bind(registry, name, &wp_presentation_interface, 1);
+        wp_presentation_add_listener(_glfw.wl.presentation,
+                                     &presentationListener,
+                                     NULL);
+    }
     else if (strcmp(interface, "zwp_relative_pointer_manager_v1") == 0)
     {
         _glfw.wl.relativePointerManager =
@@ -178,6 +243,33 @@ static void registryHandleGlobal(void* userData,
                              &zwp_idle_inhibit_manager_v1_interface,
                              1);
     }
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+    else if (strcmp(interface, "wp_fractional_scale_manager_v1") == 0)
+    {
+        _glfw.wl.fractionalScaleManager =
+            wl_registry_bind(registry, name,
+                             &wp_fractional_scale_manager_v1_interface,
+                             1);
+    }
+#endif
+#if defined(HAVE_TEARING_CONTROL_V1)
+    else if (strcmp(interface, "wp_tearing_control_manager_v1") == 0)
+    {
+        _glfw.wl.tearingControlManager =
+            wl_registry_bind(registry, name,
+                             &wp_tearing_control_manager_v1_interface,
+                             1);
+    }
+#endif
+#if defined(HAVE_CURSOR_SHAPE_V1)
+    else if (strcmp(interface, "wp_cursor_shape_manager_v1") == 0)
+    {
+        _glfw.wl.cursorShapeManager =
+            wl_registry_bind(registry, name,
+                             &wp_cursor_shape_manager_v1_interface,
+                             1);
+    }
+#endif
 }
 
 static void registryHandleGlobalRemove(void* userData,
@@ -349,39 +441,6 @@ static void createKeyTables(void)
     }
 }
 
-static GLFWbool loadCursorTheme(void)
-{
-    int cursorSize = 16;
-
-    const char* sizeString = getenv("XCURSOR_SIZE");
-    if (sizeString)
-    {
-        errno = 0;
-        const long cursorSizeLong = strtol(sizeString, NULL, 10);
-        if (errno == 0 && cursorSizeLong > 0 && cursorSizeLong < INT_MAX)
-            cursorSize = (int) cursorSizeLong;
-    }
-
-    const char* themeName = getenv("XCURSOR_THEME");
-
-    _glfw.wl.cursorTheme = wl_cursor_theme_load(themeName, cursorSize, _glfw.wl.shm);
-    if (!_glfw.wl.cursorTheme)
-    {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to load default cursor theme");
-        return GLFW_FALSE;
-    }
-
-    // If this happens to be NULL, we just fallback to the scale=1 version.
-    _glfw.wl.cursorThemeHiDPI =
-        wl_cursor_theme_load(themeName, cursorSize * 2, _glfw.wl.shm);
-
-    _glfw.wl.cursorSurface = wl_compositor_create_surface(_glfw.wl.compositor);
-    _glfw.wl.cursorTimerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
-    return GLFW_TRUE;
-}
-
-
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -406,18 +465,23 @@ GLFWbool _glfwConnectWayland(int platformID, _GLFWplatform* platform)
         _glfwGetKeyScancodeWayland,
         _glfwSetClipboardStringWayland,
         _glfwGetClipboardStringWayland,
+        _glfwRequestClipboardStringWayland,
 #if defined(GLFW_BUILD_LINUX_JOYSTICK)
         _glfwInitJoysticksLinux,
         _glfwTerminateJoysticksLinux,
         _glfwPollJoystickLinux,
+        _glfwPollJoysticksLinux,
         _glfwGetMappingNameLinux,
         _glfwUpdateGamepadGUIDLinux,
+        _glfwGetGamepadSnapshotLinux,
 #else
         _glfwInitJoysticksNull,
         _glfwTerminateJoysticksNull,
         _glfwPollJoystickNull,
+        _glfwPollJoysticksNull,
         _glfwGetMappingNameNull,
         _glfwUpdateGamepadGUIDNull,
+        _glfwGetGamepadSnapshotNull,
 #endif
         _glfwFreeMonitorWayland,
         _glfwGetMonitorPosWayland,
@@ -454,12 +518,16 @@ GLFWbool _glfwConnectWayland(int platformID, _GLFWplatform* platform)
         _glfwWindowMaximizedWayland,
         _glfwWindowHoveredWayland,
         _glfwFramebufferTransparentWayland,
+        _glfwWindowAsyncPresentationWayland,
         _glfwGetWindowOpacityWayland,
         _glfwSetWindowResizableWayland,
         _glfwSetWindowDecoratedWayland,
         _glfwSetWindowFloatingWayland,
         _glfwSetWindowOpacityWayland,
         _glfwSetWindowMousePassthroughWayland,
+        _glfwSetWindowAsyncPresentationWayland,
+        _glfwUpdateWindowEventsWayland,
+        _glfwWindowReadyForFrameWayland,
         _glfwPollEventsWayland,
         _glfwWaitEventsWayland,
         _glfwWaitEventsTimeoutWayland,
@@ -520,6 +588,8 @@ int _glfwInitWayland(void)
     // These must be set before any failure checks
     _glfw.wl.keyRepeatTimerfd = -1;
     _glfw.wl.cursorTimerfd = -1;
+    _glfw.wl.clipboardRequest.fd = -1;
+    _glfw.wl.presentationClock = CLOCK_MONOTONIC;
 
     _glfw.wl.tag = glfwGetVersionString();
 
@@ -803,8 +873,9 @@ int _glfwInitWayland(void)
         return GLFW_FALSE;
     }
 
-    if (!loadCursorTheme())
-        return GLFW_FALSE;
+    // The cursor theme is loaded on first use, as it may never be needed
+    _glfw.wl.cursorSurface = wl_compositor_create_surface(_glfw.wl.compositor);
+    _glfw.wl.cursorTimerfd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
 
     if (_glfw.wl.seat && _glfw.wl.dataDeviceManager)
     {
@@ -839,6 +910,7 @@ void _glfwTerminateWayland(void)
 
     if (_glfw.wl.xkb.composeState)
         xkb_compose_state_unref(_glfw.wl.xkb.composeState);
+    _glfw_free(_glfw.wl.xkb.composeLocale);
     if (_glfw.wl.xkb.keymap)
         xkb_keymap_unref(_glfw.wl.xkb.keymap);
     if (_glfw.wl.xkb.state)
@@ -861,6 +933,16 @@ void _glfwTerminateWayland(void)
         _glfw.wl.cursor.handle = NULL;
     }
 
+    if (_glfw.wl.decorationBuffer)
+        wl_buffer_destroy(_glfw.wl.decorationBuffer);
+    if (_glfw.wl.shmPool.pool)
+    {
+        wl_shm_pool_destroy(_glfw.wl.shmPool.pool);
+        munmap(_glfw.wl.shmPool.data, _glfw.wl.shmPool.size);
+        close(_glfw.wl.shmPool.fd);
+    }
+    _glfw_free(_glfw.wl.shmPool.ranges);
+
     for (unsigned int i = 0; i < _glfw.wl.offerCount; i++)
         wl_data_offer_destroy(_glfw.wl.offers[i].offer);
 
@@ -876,6 +958,8 @@ void _glfwTerminateWayland(void)
         wl_shm_destroy(_glfw.wl.shm);
     if (_glfw.wl.viewporter)
         wp_viewporter_destroy(_glfw.wl.viewporter);
+    if (_glfw.wl.presentation)
+        wp_presentation_destroy(_glfw.wl.presentation);
     if (_glfw.wl.decorationManager)
         zxdg_decoration_manager_v1_destroy(_glfw.wl.decorationManager);
     if (_glfw.wl.wmBase)
@@ -890,6 +974,10 @@ void _glfwTerminateWayland(void)
         wl_data_device_destroy(_glfw.wl.dataDevice);
     if (_glfw.wl.dataDeviceManager)
         wl_data_device_manager_destroy(_glfw.wl.dataDeviceManager);
+#if defined(HAVE_CURSOR_SHAPE_V1)
+    if (_glfw.wl.cursorShapeDevice)
+        wp_cursor_shape_device_v1_destroy(_glfw.wl.cursorShapeDevice);
+#endif
     if (_glfw.wl.pointer)
         wl_pointer_destroy(_glfw.wl.pointer);
     if (_glfw.wl.keyboard)
@@ -902,6 +990,18 @@ void _glfwTerminateWayland(void)
         zwp_pointer_constraints_v1_destroy(_glfw.wl.pointerConstraints);
     if (_glfw.wl.idleInhibitManager)
         zwp_idle_inhibit_manager_v1_destroy(_glfw.wl.idleInhibitManager);
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+    if (_glfw.wl.fractionalScaleManager)
+        wp_fractional_scale_manager_v1_destroy(_glfw.wl.fractionalScaleManager);
+#endif
+#if defined(HAVE_TEARING_CONTROL_V1)
+    if (_glfw.wl.tearingControlManager)
+        wp_tearing_control_manager_v1_destroy(_glfw.wl.tearingControlManager);
+#endif
+#if defined(HAVE_CURSOR_SHAPE_V1)
+    if (_glfw.wl.cursorShapeManager)
+        wp_cursor_shape_manager_v1_destroy(_glfw.wl.cursorShapeManager);
+#endif
     if (_glfw.wl.registry)
         wl_registry_destroy(_glfw.wl.registry);
     if (_glfw.wl.display)
@@ -914,8 +1014,11 @@ void _glfwTerminateWayland(void)
         close(_glfw.wl.keyRepeatTimerfd);
     if (_glfw.wl.cursorTimerfd >= 0)
         close(_glfw.wl.cursorTimerfd);
+    if (_glfw.wl.clipboardRequest.fd >= 0)
+        close(_glfw.wl.clipboardRequest.fd);
 
     _glfw_free(_glfw.wl.clipboardString);
+    _glfw_free(_glfw.wl.clipboardRequest.string);
 }
 
 #endif // _GLFW_WAYLAND
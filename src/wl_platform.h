@@ -337,6 +337,33 @@ typedef struct _GLFWdecorationWayland
     struct wp_viewport*         viewport;
 } _GLFWdecorationWayland;
 
+// Pointer input accumulated until the end of a wl_pointer frame
+//
+typedef struct _GLFWpointerFrameWayland
+{
+    GLFWbool                    motion;
+    struct {
+        uint32_t                button;
+        uint32_t                state;
+    }                           buttons[16];
+    int                         buttonCount;
+    GLFWbool                    scrolled;
+    // Continuous scroll distance in surface coordinates
+    double                      scrollX, scrollY;
+    // Discrete wheel scrolling in 120ths of a step, replacing the above
+    GLFWbool                    steppedX, steppedY;
+    int32_t                     steps120X, steps120Y;
+} _GLFWpointerFrameWayland;
+
+// A buffer sub-allocated from the shared memory pool
+//
+typedef struct _GLFWshmRangeWayland
+{
+    struct wl_buffer*           buffer;
+    int                         offset;
+    int                         size;
+} _GLFWshmRangeWayland;
+
 typedef struct _GLFWofferWayland
 {
     struct wl_data_offer*       offer;
@@ -362,7 +389,10 @@ typedef struct _GLFWwindowWayland
     GLFWbool                    hovered;
     GLFWbool                    transparent;
     struct wl_surface*          surface;
-    struct wl_callback*         callback;
+    // Frame callback for the last swap, used by glfwWindowReadyForFrame
+    struct wl_callback*         frameCallback;
+    // Whether frame callbacks are requested, set at the first readiness query
+    GLFWbool                    frameTracking;
 
     struct {
         struct wl_egl_window*   window;
@@ -401,6 +431,22 @@ typedef struct _GLFWwindowWayland
     int                         scaleCount;
     int                         scaleSize;
 
+    // Fractional scaling, where the framebuffer is presented 1:1 via a viewport
+    // and the integer content scale above is only used for cursors
+    struct wp_fractional_scale_v1*  fractionalScale;
+    struct wp_viewport*             scalingViewport;
+    // The preferred scale in 120ths, as sent by the compositor
+    uint32_t                        scalingNumerator;
+
+    // Presentation hint object, created the first time async presentation is set
+    struct wp_tearing_control_v1*   tearingControl;
+    GLFWbool                        asyncPresentation;
+
+    // Presentation feedback requested for frames not yet presented
+    struct wp_presentation_feedback**  feedbacks;
+    int                         feedbackCount;
+    int                         feedbackSize;
+
     struct zwp_relative_pointer_v1* relativePointer;
     struct zwp_locked_pointer_v1*   lockedPointer;
     struct zwp_confined_pointer_v1* confinedPointer;
@@ -408,7 +454,6 @@ typedef struct _GLFWwindowWayland
     struct zwp_idle_inhibitor_v1*          idleInhibitor;
 
     struct {
-        struct wl_buffer*                  buffer;
         _GLFWdecorationWayland             top, left, right, bottom;
         _GLFWdecorationSideWayland         focus;
     } decorations;
@@ -431,9 +476,29 @@ typedef struct _GLFWlibraryWayland
     struct xdg_wm_base*         wmBase;
     struct zxdg_decoration_manager_v1*      decorationManager;
     struct wp_viewporter*       viewporter;
+    struct wp_presentation*     presentation;
+    // The clock used for presentation timestamps
+    uint32_t                    presentationClock;
     struct zwp_relative_pointer_manager_v1* relativePointerManager;
     struct zwp_pointer_constraints_v1*      pointerConstraints;
     struct zwp_idle_inhibit_manager_v1*     idleInhibitManager;
+    struct wp_fractional_scale_manager_v1*  fractionalScaleManager;
+    struct wp_tearing_control_manager_v1*   tearingControlManager;
+    struct wp_cursor_shape_manager_v1*      cursorShapeManager;
+    struct wp_cursor_shape_device_v1*       cursorShapeDevice;
+
+    // Shared memory pool for cursor images and fallback decorations, with its
+    // allocated ranges sorted by offset
+    struct {
+        struct wl_shm_pool*     pool;
+        int                     fd;
+        unsigned char*          data;
+        int                     size;
+        _GLFWshmRangeWayland*   ranges;
+        int                     rangeCount;
+    } shmPool;
+    // The fallback decoration buffer, shared by all windows
+    struct wl_buffer*           decorationBuffer;
 
     _GLFWofferWayland*          offers;
     unsigned int                offerCount;
@@ -447,6 +512,13 @@ typedef struct _GLFWlibraryWayland
 
     const char*                 tag;
 
+    _GLFWpointerFrameWayland    pointerFrame;
+
+    // Whether requests are buffered because the compositor is not reading them
+    GLFWbool                    flushPending;
+
+    // The cursor themes are only loaded once a standard cursor needs them
+    GLFWbool                    cursorThemeLoaded;
     struct wl_cursor_theme*     cursorTheme;
     struct wl_cursor_theme*     cursorThemeHiDPI;
     struct wl_surface*          cursorSurface;
@@ -461,6 +533,18 @@ typedef struct _GLFWlibraryWayland
     int                         keyRepeatScancode;
 
     char*                       clipboardString;
+
+    // Asynchronous clipboard request started by glfwRequestClipboardString
+    struct {
+        // Read end of the data offer pipe, or -1 if there is no request
+        int                     fd;
+        char*                   string;
+        size_t                  length;
+        size_t                  size;
+        // Timer value after which the request is abandoned
+        uint64_t                deadline;
+    } clipboardRequest;
+
     short int                   keycodes[256];
     short int                   scancodes[GLFW_KEY_LAST + 1];
     char                        keynames[GLFW_KEY_LAST + 1][5];
@@ -470,8 +554,13 @@ typedef struct _GLFWlibraryWayland
         struct xkb_context*     context;
         struct xkb_keymap*      keymap;
         struct xkb_state*       state;
+        // Identifies the text of the current keymap, to skip recompiling it
+        uint32_t                keymapSize;
+        uint64_t                keymapHash;
 
         struct xkb_compose_state* composeState;
+        // The locale the current compose state was created for
+        char*                   composeLocale;
 
         xkb_mod_index_t         controlIndex;
         xkb_mod_index_t         altIndex;
@@ -601,6 +690,8 @@ typedef struct _GLFWcursorWayland
     int                         width, height;
     int                         xhot, yhot;
     int                         currentImage;
+    // The wp_cursor_shape_device_v1 shape of a standard cursor, or zero
+    uint32_t                    shape;
 } _GLFWcursorWayland;
 
 GLFWbool _glfwConnectWayland(int platformID, _GLFWplatform* platform);
@@ -634,12 +725,16 @@ GLFWbool _glfwWindowVisibleWayland(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedWayland(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredWayland(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentWayland(_GLFWwindow* window);
+GLFWbool _glfwWindowAsyncPresentationWayland(_GLFWwindow* window);
 void _glfwSetWindowResizableWayland(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedWayland(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowFloatingWayland(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityWayland(_GLFWwindow* window);
 void _glfwSetWindowOpacityWayland(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughWayland(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowAsyncPresentationWayland(_GLFWwindow* window, GLFWbool enabled);
+void _glfwUpdateWindowEventsWayland(_GLFWwindow* window);
+GLFWbool _glfwWindowReadyForFrameWayland(_GLFWwindow* window);
 
 void _glfwSetRawMouseMotionWayland(_GLFWwindow* window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedWayland(void);
@@ -660,6 +755,7 @@ void _glfwDestroyCursorWayland(_GLFWcursor* cursor);
 void _glfwSetCursorWayland(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringWayland(const char* string);
 const char* _glfwGetClipboardStringWayland(void);
+void _glfwRequestClipboardStringWayland(void);
 
 EGLenum _glfwGetEGLPlatformWayland(EGLint** attribs);
 EGLNativeDisplayType _glfwGetEGLNativeDisplayWayland(void);
@@ -680,6 +776,7 @@ void _glfwSetGammaRampWayland(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
 
 void _glfwAddOutputWayland(uint32_t name, uint32_t version);
 void _glfwUpdateContentScaleWayland(_GLFWwindow* window);
+void _glfwPrepareSwapBuffersWayland(_GLFWwindow* window);
 
 void _glfwAddSeatListenerWayland(struct wl_seat* seat);
 void _glfwAddDataDeviceListenerWayland(struct wl_data_device* device);
@@ -36,21 +36,36 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <assert.h>
+#include <limits.h>
 #include <unistd.h>
 #include <string.h>
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/timerfd.h>
 #include <poll.h>
+#include <time.h>
 
 #include "wayland-client-protocol.h"
 #include "wayland-xdg-shell-client-protocol.h"
 #include "wayland-xdg-decoration-client-protocol.h"
 #include "wayland-viewporter-client-protocol.h"
+#include "wayland-presentation-time-client-protocol.h"
 #include "wayland-relative-pointer-unstable-v1-client-protocol.h"
 #include "wayland-pointer-constraints-unstable-v1-client-protocol.h"
 #include "wayland-idle-inhibit-unstable-v1-client-protocol.h"
 
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+#include "wayland-fractional-scale-v1-client-protocol.h"
+#endif
+
+#if defined(HAVE_TEARING_CONTROL_V1)
+#include "wayland-tearing-control-v1-client-protocol.h"
+#endif
+
+#if defined(HAVE_CURSOR_SHAPE_V1)
+#include "wayland-cursor-shape-v1-client-protocol.h"
+#endif
+
 #define GLFW_BORDER_SIZE    4
 #define GLFW_CAPTION_HEIGHT 24
 
@@ -65,6 +80,21 @@ static int createTmpfileCloexec(char* tmpname)
     return fd;
 }
 
+// Grows the specified anonymous file to the specified size, returning zero on
+// success or an error number on failure
+//
+static int growAnonymousFile(int fd, off_t size)
+{
+#if defined(SHM_ANON)
+    // posix_fallocate does not work on SHM descriptors
+    if (ftruncate(fd, size) != 0)
+        return errno;
+    return 0;
+#else
+    return posix_fallocate(fd, 0, size);
+#endif
+}
+
 /*
  * Create a new, unique, anonymous file of the given size, and
  * return the file descriptor for it. The file descriptor is set
@@ -127,12 +157,7 @@ static int createAnonymousFile(off_t size)
             return -1;
     }
 
-#if defined(SHM_ANON)
-    // posix_fallocate does not work on SHM descriptors
-    ret = ftruncate(fd, size);
-#else
-    ret = posix_fallocate(fd, 0, size);
-#endif
+    ret = growAnonymousFile(fd, size);
     if (ret != 0)
     {
         close(fd);
@@ -142,35 +167,95 @@ static int createAnonymousFile(off_t size)
     return fd;
 }
 
-static struct wl_buffer* createShmBuffer(const GLFWimage* image)
+// Ensures the shared memory pool is at least the specified size
+//
+static GLFWbool growShmPool(int size)
 {
-    const int stride = image->width * 4;
-    const int length = image->width * image->height * 4;
+    int ret;
 
-    const int fd = createAnonymousFile(length);
-    if (fd < 0)
+    if (size <= _glfw.wl.shmPool.size)
+        return GLFW_TRUE;
+
+    // Grow geometrically so that most allocations do not remap the pool
+    size = _glfw_max(size, _glfw_max(_glfw.wl.shmPool.size * 2, 16384));
+
+    if (_glfw.wl.shmPool.pool)
+        ret = growAnonymousFile(_glfw.wl.shmPool.fd, size);
+    else
+    {
+        _glfw.wl.shmPool.fd = createAnonymousFile(size);
+        ret = _glfw.wl.shmPool.fd < 0 ? errno : 0;
+    }
+
+    if (ret != 0)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Failed to create buffer file of size %d: %s",
-                        length, strerror(errno));
-        return NULL;
+                        size, strerror(ret));
+        return GLFW_FALSE;
     }
 
-    void* data = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void* data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      _glfw.wl.shmPool.fd, 0);
     if (data == MAP_FAILED)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Failed to map file: %s", strerror(errno));
-        close(fd);
-        return NULL;
+
+        if (!_glfw.wl.shmPool.pool)
+            close(_glfw.wl.shmPool.fd);
+
+        return GLFW_FALSE;
     }
 
-    struct wl_shm_pool* pool = wl_shm_create_pool(_glfw.wl.shm, fd, length);
+    if (_glfw.wl.shmPool.data)
+        munmap(_glfw.wl.shmPool.data, _glfw.wl.shmPool.size);
 
-    close(fd);
+    if (_glfw.wl.shmPool.pool)
+        wl_shm_pool_resize(_glfw.wl.shmPool.pool, size);
+    else
+    {
+        _glfw.wl.shmPool.pool =
+            wl_shm_create_pool(_glfw.wl.shm, _glfw.wl.shmPool.fd, size);
+    }
+
+    _glfw.wl.shmPool.data = data;
+    _glfw.wl.shmPool.size = size;
+    return GLFW_TRUE;
+}
+
+static struct wl_buffer* createShmBuffer(const GLFWimage* image)
+{
+    const int stride = image->width * 4;
+    const int length = image->width * image->height * 4;
+    int index, offset = 0;
+
+    // Use the first gap between existing buffers that fits, if any
+    for (index = 0;  index < _glfw.wl.shmPool.rangeCount;  index++)
+    {
+        const _GLFWshmRangeWayland* range = _glfw.wl.shmPool.ranges + index;
+        if (range->offset - offset >= length)
+            break;
+
+        offset = range->offset + range->size;
+    }
+
+    if (!growShmPool(offset + length))
+        return NULL;
+
+    _GLFWshmRangeWayland* ranges =
+        _glfw_realloc(_glfw.wl.shmPool.ranges,
+                      sizeof(_GLFWshmRangeWayland) * (_glfw.wl.shmPool.rangeCount + 1));
+    if (!ranges)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return NULL;
+    }
+
+    _glfw.wl.shmPool.ranges = ranges;
 
     unsigned char* source = (unsigned char*) image->pixels;
-    unsigned char* target = data;
+    unsigned char* target = _glfw.wl.shmPool.data + offset;
     for (int i = 0;  i < image->width * image->height;  i++, source += 4)
     {
         unsigned int alpha = source[3];
@@ -182,16 +267,39 @@ static struct wl_buffer* createShmBuffer(const GLFWimage* image)
     }
 
     struct wl_buffer* buffer =
-        wl_shm_pool_create_buffer(pool, 0,
+        wl_shm_pool_create_buffer(_glfw.wl.shmPool.pool, offset,
                                   image->width,
                                   image->height,
                                   stride, WL_SHM_FORMAT_ARGB8888);
-    munmap(data, length);
-    wl_shm_pool_destroy(pool);
+
+    memmove(_glfw.wl.shmPool.ranges + index + 1,
+            _glfw.wl.shmPool.ranges + index,
+            sizeof(_GLFWshmRangeWayland) * (_glfw.wl.shmPool.rangeCount - index));
+    _glfw.wl.shmPool.ranges[index].buffer = buffer;
+    _glfw.wl.shmPool.ranges[index].offset = offset;
+    _glfw.wl.shmPool.ranges[index].size = length;
+    _glfw.wl.shmPool.rangeCount++;
 
     return buffer;
 }
 
+static void destroyShmBuffer(struct wl_buffer* buffer)
+{
+    for (int i = 0;  i < _glfw.wl.shmPool.rangeCount;  i++)
+    {
+        if (_glfw.wl.shmPool.ranges[i].buffer == buffer)
+        {
+            _glfw.wl.shmPool.rangeCount--;
+            memmove(_glfw.wl.shmPool.ranges + i,
+                    _glfw.wl.shmPool.ranges + i + 1,
+                    sizeof(_GLFWshmRangeWayland) * (_glfw.wl.shmPool.rangeCount - i));
+            break;
+        }
+    }
+
+    wl_buffer_destroy(buffer);
+}
+
 static void createFallbackDecoration(_GLFWwindow* window,
                                      _GLFWdecorationWayland* decoration,
                                      struct wl_surface* parent,
@@ -226,25 +334,25 @@ static void createFallbackDecorations(_GLFWwindow* window)
     if (!_glfw.wl.viewporter)
         return;
 
-    if (!window->wl.decorations.buffer)
-        window->wl.decorations.buffer = createShmBuffer(&image);
-    if (!window->wl.decorations.buffer)
+    if (!_glfw.wl.decorationBuffer)
+        _glfw.wl.decorationBuffer = createShmBuffer(&image);
+    if (!_glfw.wl.decorationBuffer)
         return;
 
     createFallbackDecoration(window, &window->wl.decorations.top, window->wl.surface,
-                             window->wl.decorations.buffer,
+                             _glfw.wl.decorationBuffer,
                              0, -GLFW_CAPTION_HEIGHT,
                              window->wl.width, GLFW_CAPTION_HEIGHT);
     createFallbackDecoration(window, &window->wl.decorations.left, window->wl.surface,
-                             window->wl.decorations.buffer,
+                             _glfw.wl.decorationBuffer,
                              -GLFW_BORDER_SIZE, -GLFW_CAPTION_HEIGHT,
                              GLFW_BORDER_SIZE, window->wl.height + GLFW_CAPTION_HEIGHT);
     createFallbackDecoration(window, &window->wl.decorations.right, window->wl.surface,
-                             window->wl.decorations.buffer,
+                             _glfw.wl.decorationBuffer,
                              window->wl.width, -GLFW_CAPTION_HEIGHT,
                              GLFW_BORDER_SIZE, window->wl.height + GLFW_CAPTION_HEIGHT);
     createFallbackDecoration(window, &window->wl.decorations.bottom, window->wl.surface,
-                             window->wl.decorations.buffer,
+                             _glfw.wl.decorationBuffer,
                              -GLFW_BORDER_SIZE, window->wl.height,
                              window->wl.width + GLFW_BORDER_SIZE * 2, GLFW_BORDER_SIZE);
 }
@@ -307,11 +415,36 @@ static void setContentAreaOpaque(_GLFWwindow* window)
 }
 
 
+// Returns the framebuffer size for the current window size and scale
+//
+static void getFramebufferSize(_GLFWwindow* window, int* fbWidth, int* fbHeight)
+{
+    const int width = window->wl.width;
+    const int height = window->wl.height;
+
+    if (window->wl.fractionalScale)
+    {
+        // The protocol asks for rounding half away from zero
+        *fbWidth = (int) ((width * window->wl.scalingNumerator + 60) / 120);
+        *fbHeight = (int) ((height * window->wl.scalingNumerator + 60) / 120);
+    }
+    else
+    {
+        *fbWidth = width * window->wl.contentScale;
+        *fbHeight = height * window->wl.contentScale;
+    }
+}
+
 static void resizeWindow(_GLFWwindow* window)
 {
-    int scale = window->wl.contentScale;
-    int scaledWidth = window->wl.width * scale;
-    int scaledHeight = window->wl.height * scale;
+    int scaledWidth, scaledHeight;
+    getFramebufferSize(window, &scaledWidth, &scaledHeight);
+
+    if (window->wl.scalingViewport)
+    {
+        wp_viewport_set_destination(window->wl.scalingViewport,
+                                    window->wl.width, window->wl.height);
+    }
 
     if (window->wl.egl.window)
         wl_egl_window_resize(window->wl.egl.window, scaledWidth, scaledHeight, 0, 0);
@@ -345,6 +478,10 @@ static void resizeWindow(_GLFWwindow* window)
 
 void _glfwUpdateContentScaleWayland(_GLFWwindow* window)
 {
+    // The compositor sends the preferred fractional scale directly
+    if (window->wl.fractionalScale)
+        return;
+
     if (wl_compositor_get_version(_glfw.wl.compositor) <
         WL_SURFACE_SET_BUFFER_SCALE_SINCE_VERSION)
     {
@@ -425,6 +562,33 @@ static const struct wl_surface_listener surfaceListener =
     surfaceHandleLeave
 };
 
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+static void fractionalScaleHandlePreferredScale(void* userData,
+                                                struct wp_fractional_scale_v1* fractionalScale,
+                                                uint32_t numerator)
+{
+    _GLFWwindow* window = userData;
+
+    if (window->wl.scalingNumerator == numerator)
+        return;
+
+    const float scale = numerator / 120.f;
+
+    window->wl.scalingNumerator = numerator;
+    window->wl.contentScale = (int) ((numerator + 119) / 120);
+    _glfwInputWindowContentScale(window, scale, scale);
+    resizeWindow(window);
+
+    if (window->wl.visible)
+        _glfwInputWindowDamage(window);
+}
+
+static const struct wp_fractional_scale_v1_listener fractionalScaleListener =
+{
+    fractionalScaleHandlePreferredScale
+};
+#endif
+
 static void setIdleInhibitor(_GLFWwindow* window, GLFWbool enable)
 {
     if (enable && !window->wl.idleInhibitor && _glfw.wl.idleInhibitManager)
@@ -935,6 +1099,129 @@ static void destroyShellObjects(_GLFWwindow* window)
     window->wl.xdg.surface = NULL;
 }
 
+// Removes the specified presentation feedback from the window and destroys it
+//
+static void destroyPresentationFeedback(_GLFWwindow* window,
+                                        struct wp_presentation_feedback* feedback)
+{
+    for (int i = 0; i < window->wl.feedbackCount; i++)
+    {
+        if (window->wl.feedbacks[i] == feedback)
+        {
+            window->wl.feedbacks[i] = window->wl.feedbacks[window->wl.feedbackCount - 1];
+            window->wl.feedbackCount--;
+            break;
+        }
+    }
+
+    wp_presentation_feedback_destroy(feedback);
+}
+
+// Converts a presentation clock timestamp to the GLFW time base
+//
+static double getPresentationTime(uint64_t seconds, uint32_t nanoseconds)
+{
+    struct timespec now;
+    clock_gettime(_glfw.wl.presentationClock, &now);
+
+    const double age = (double) ((int64_t) now.tv_sec - (int64_t) seconds) +
+                       ((long) now.tv_nsec - (long) nanoseconds) / 1e9;
+    const double time = (_glfwPlatformGetTimerValue() - _glfw.timer.offset) /
+                        (double) _glfwPlatformGetTimerFrequency();
+
+    return time - age;
+}
+
+static void feedbackHandleSyncOutput(void* userData,
+                                     struct wp_presentation_feedback* feedback,
+                                     struct wl_output* output)
+{
+}
+
+static void feedbackHandlePresented(void* userData,
+                                    struct wp_presentation_feedback* feedback,
+                                    uint32_t secondsHigh,
+                                    uint32_t secondsLow,
+                                    uint32_t nanoseconds,
+                                    uint32_t refresh,
+                                    uint32_t sequenceHigh,
+                                    uint32_t sequenceLow,
+                                    uint32_t flags)
+{
+    _GLFWwindow* window = userData;
+    const uint64_t seconds = ((uint64_t) secondsHigh << 32) | secondsLow;
+    const uint64_t sequence = ((uint64_t) sequenceHigh << 32) | sequenceLow;
+
+    destroyPresentationFeedback(window, feedback);
+    _glfwInputWindowPresent(window,
+                            getPresentationTime(seconds, nanoseconds),
+                            refresh / 1e9,
+                            sequence);
+}
+
+static void feedbackHandleDiscarded(void* userData,
+                                    struct wp_presentation_feedback* feedback)
+{
+    destroyPresentationFeedback(userData, feedback);
+}
+
+static const struct wp_presentation_feedback_listener feedbackListener =
+{
+    feedbackHandleSyncOutput,
+    feedbackHandlePresented,
+    feedbackHandleDiscarded
+};
+
+static void frameCallbackHandleDone(void* userData,
+                                    struct wl_callback* callback,
+                                    uint32_t time)
+{
+    _GLFWwindow* window = userData;
+
+    wl_callback_destroy(callback);
+    window->wl.frameCallback = NULL;
+}
+
+static const struct wl_callback_listener frameCallbackListener =
+{
+    frameCallbackHandleDone
+};
+
+// Requests per-frame surface state that must be in place before the commit
+// made by eglSwapBuffers
+//
+void _glfwPrepareSwapBuffersWayland(_GLFWwindow* window)
+{
+    if (window->wl.frameTracking && !window->wl.frameCallback)
+    {
+        // The compositor signals this when it is a good time to draw again
+        window->wl.frameCallback = wl_surface_frame(window->wl.surface);
+        wl_callback_add_listener(window->wl.frameCallback,
+                                 &frameCallbackListener,
+                                 window);
+    }
+
+    if (window->callbacks.present && _glfw.wl.presentation)
+    {
+        if (window->wl.feedbackCount + 1 > window->wl.feedbackSize)
+        {
+            struct wp_presentation_feedback** feedbacks =
+                _glfw_realloc(window->wl.feedbacks,
+                              (window->wl.feedbackSize + 1) * sizeof(*feedbacks));
+            if (!feedbacks)
+                return;
+
+            window->wl.feedbacks = feedbacks;
+            window->wl.feedbackSize++;
+        }
+
+        struct wp_presentation_feedback* feedback =
+            wp_presentation_feedback(_glfw.wl.presentation, window->wl.surface);
+        wp_presentation_feedback_add_listener(feedback, &feedbackListener, window);
+        window->wl.feedbacks[window->wl.feedbackCount++] = feedback;
+    }
+}
+
 static GLFWbool createNativeSurface(_GLFWwindow* window,
                                     const _GLFWwndconfig* wndconfig,
                                     const _GLFWfbconfig* fbconfig)
@@ -954,6 +1241,7 @@ static GLFWbool createNativeSurface(_GLFWwindow* window,
     window->wl.width = wndconfig->width;
     window->wl.height = wndconfig->height;
     window->wl.contentScale = 1;
+    window->wl.scalingNumerator = 120;
     window->wl.title = _glfw_strdup(wndconfig->title);
     window->wl.appId = _glfw_strdup(wndconfig->wl.appId);
 
@@ -963,9 +1251,85 @@ static GLFWbool createNativeSurface(_GLFWwindow* window,
     if (!window->wl.transparent)
         setContentAreaOpaque(window);
 
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+    if (_glfw.wl.fractionalScaleManager && _glfw.wl.viewporter)
+    {
+        // The buffer keeps a scale of one and is mapped to the surface size by
+        // the viewport, so it can have any fractional size
+        window->wl.scalingViewport =
+            wp_viewporter_get_viewport(_glfw.wl.viewporter, window->wl.surface);
+        wp_viewport_set_destination(window->wl.scalingViewport,
+                                    window->wl.width, window->wl.height);
+
+        window->wl.fractionalScale =
+            wp_fractional_scale_manager_v1_get_fractional_scale(
+                _glfw.wl.fractionalScaleManager,
+                window->wl.surface);
+        wp_fractional_scale_v1_add_listener(window->wl.fractionalScale,
+                                            &fractionalScaleListener,
+                                            window);
+    }
+#endif
+
+    return GLFW_TRUE;
+}
+
+// Loads the cursor themes the first time they are needed, returning whether
+// the default theme is available
+//
+static GLFWbool loadCursorTheme(void)
+{
+    if (_glfw.wl.cursorThemeLoaded)
+        return _glfw.wl.cursorTheme != NULL;
+
+    _glfw.wl.cursorThemeLoaded = GLFW_TRUE;
+
+    int cursorSize = 16;
+
+    const char* sizeString = getenv("XCURSOR_SIZE");
+    if (sizeString)
+    {
+        errno = 0;
+        const long cursorSizeLong = strtol(sizeString, NULL, 10);
+        if (errno == 0 && cursorSizeLong > 0 && cursorSizeLong < INT_MAX)
+            cursorSize = (int) cursorSizeLong;
+    }
+
+    const char* themeName = getenv("XCURSOR_THEME");
+
+    _glfw.wl.cursorTheme = wl_cursor_theme_load(themeName, cursorSize, _glfw.wl.shm);
+    if (!_glfw.wl.cursorTheme)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to load default cursor theme");
+        return GLFW_FALSE;
+    }
+
+    // If this happens to be NULL, we just fallback to the scale=1 version.
+    _glfw.wl.cursorThemeHiDPI =
+        wl_cursor_theme_load(themeName, cursorSize * 2, _glfw.wl.shm);
+
     return GLFW_TRUE;
 }
 
+#if defined(HAVE_CURSOR_SHAPE_V1)
+// Names the cursor shape for the compositor to draw from its own theme
+//
+static void setCursorShape(uint32_t shape)
+{
+    if (!_glfw.wl.cursorShapeDevice)
+    {
+        _glfw.wl.cursorShapeDevice =
+            wp_cursor_shape_manager_v1_get_pointer(_glfw.wl.cursorShapeManager,
+                                                   _glfw.wl.pointer);
+    }
+
+    wp_cursor_shape_device_v1_set_shape(_glfw.wl.cursorShapeDevice,
+                                        _glfw.wl.pointerEnterSerial,
+                                        shape);
+}
+#endif
+
 static void setCursorImage(_GLFWwindow* window,
                            _GLFWcursorWayland* cursorWayland)
 {
@@ -976,6 +1340,14 @@ static void setCursorImage(_GLFWwindow* window,
     struct wl_surface* surface = _glfw.wl.cursorSurface;
     int scale = 1;
 
+#if defined(HAVE_CURSOR_SHAPE_V1)
+    if (cursorWayland->shape)
+    {
+        setCursorShape(cursorWayland->shape);
+        return;
+    }
+#endif
+
     if (!wlCursor)
         buffer = cursorWayland->buffer;
     else
@@ -1028,7 +1400,29 @@ static void incrementCursorImage(_GLFWwindow* window)
     }
 }
 
+// Sends buffered requests without blocking
+//
+// If the socket is full the remaining requests stay buffered and are sent by
+// handleEvents once the compositor has caught up
+//
 static GLFWbool flushDisplay(void)
+{
+    if (wl_display_flush(_glfw.wl.display) == -1)
+    {
+        if (errno != EAGAIN)
+            return GLFW_FALSE;
+
+        _glfw.wl.flushPending = GLFW_TRUE;
+    }
+    else
+        _glfw.wl.flushPending = GLFW_FALSE;
+
+    return GLFW_TRUE;
+}
+
+// Sends all buffered requests, waiting for the compositor if necessary
+//
+static GLFWbool flushDisplaySync(void)
 {
     while (wl_display_flush(_glfw.wl.display) == -1)
     {
@@ -1044,6 +1438,7 @@ static GLFWbool flushDisplay(void)
         }
     }
 
+    _glfw.wl.flushPending = GLFW_FALSE;
     return GLFW_TRUE;
 }
 
@@ -1093,20 +1488,138 @@ static void inputText(_GLFWwindow* window, uint32_t scancode)
     }
 }
 
+// Returns the number of seconds left before the clipboard request times out
+//
+static double getClipboardRequestTimeout(void)
+{
+    const uint64_t now = _glfwPlatformGetTimerValue();
+    if (now >= _glfw.wl.clipboardRequest.deadline)
+        return 0.0;
+
+    return (double) (_glfw.wl.clipboardRequest.deadline - now) /
+        _glfwPlatformGetTimerFrequency();
+}
+
+// Pushes back the clipboard request timeout after progress has been made
+//
+static void extendClipboardRequest(void)
+{
+    _glfw.wl.clipboardRequest.deadline = _glfwPlatformGetTimerValue() +
+        (uint64_t) (_GLFW_CLIPBOARD_TIMEOUT * _glfwPlatformGetTimerFrequency());
+}
+
+// Ends the clipboard request and passes any received string to the callback
+//
+static void endClipboardRequest(GLFWbool success)
+{
+    char* string = _glfw.wl.clipboardRequest.string;
+
+    close(_glfw.wl.clipboardRequest.fd);
+    _glfw.wl.clipboardRequest.fd = -1;
+    _glfw.wl.clipboardRequest.string = NULL;
+    _glfw.wl.clipboardRequest.length = 0;
+    _glfw.wl.clipboardRequest.size = 0;
+
+    _glfwInputClipboardString(success ? string : NULL);
+    _glfw_free(string);
+}
+
+// Reads whatever clipboard data is available from the data offer pipe without
+// blocking, ending the request when the pipe is closed
+// Returns whether the request has ended
+//
+static GLFWbool readClipboardRequest(void)
+{
+    for (;;)
+    {
+        const size_t readSize = 4096;
+        const size_t length = _glfw.wl.clipboardRequest.length;
+        const size_t requiredSize = length + readSize + 1;
+        if (requiredSize > _glfw.wl.clipboardRequest.size)
+        {
+            // Grow geometrically to keep large transfers linear
+            size_t size = _glfw.wl.clipboardRequest.size * 2;
+            if (size < requiredSize)
+                size = requiredSize;
+
+            char* longer = _glfw_realloc(_glfw.wl.clipboardRequest.string, size);
+            if (!longer)
+            {
+                _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+                endClipboardRequest(GLFW_FALSE);
+                return GLFW_TRUE;
+            }
+
+            _glfw.wl.clipboardRequest.string = longer;
+            _glfw.wl.clipboardRequest.size = size;
+        }
+
+        char* string = _glfw.wl.clipboardRequest.string;
+        const ssize_t result =
+            read(_glfw.wl.clipboardRequest.fd, string + length, readSize);
+        if (result == 0)
+        {
+            string[length] = '\0';
+            endClipboardRequest(GLFW_TRUE);
+            return GLFW_TRUE;
+        }
+        else if (result == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN)
+                return GLFW_FALSE;
+
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to read from data offer pipe: %s",
+                            strerror(errno));
+            endClipboardRequest(GLFW_FALSE);
+            return GLFW_TRUE;
+        }
+
+        _glfw.wl.clipboardRequest.length += result;
+        extendClipboardRequest();
+    }
+}
+
+// Abandons the clipboard request if the owner has stopped sending data
+// Returns whether the request was abandoned
+//
+static GLFWbool expireClipboardRequest(void)
+{
+    if (_glfw.wl.clipboardRequest.fd < 0 || getClipboardRequestTimeout() > 0.0)
+        return GLFW_FALSE;
+
+    _glfwInputError(GLFW_PLATFORM_ERROR,
+                    "Wayland: Timed out waiting for clipboard data");
+    endClipboardRequest(GLFW_FALSE);
+    return GLFW_TRUE;
+}
+
 static void handleEvents(double* timeout)
 {
     GLFWbool event = GLFW_FALSE;
-    struct pollfd fds[4] =
+    struct pollfd fds[5 + GLFW_JOYSTICK_LAST + 2] =
     {
         { wl_display_get_fd(_glfw.wl.display), POLLIN },
         { _glfw.wl.keyRepeatTimerfd, POLLIN },
         { _glfw.wl.cursorTimerfd, POLLIN },
-        { -1, POLLIN }
+        { -1, POLLIN },
+        { _glfw.wl.clipboardRequest.fd, POLLIN }
     };
 
     if (_glfw.wl.libdecor.context)
         fds[3].fd = libdecor_get_fd(_glfw.wl.libdecor.context);
 
+    double requestTimeout;
+    if (_glfw.wl.clipboardRequest.fd >= 0)
+    {
+        // Wake up in time to abandon an unresponsive clipboard owner
+        requestTimeout = getClipboardRequestTimeout();
+        if (!timeout || requestTimeout < *timeout)
+            timeout = &requestTimeout;
+    }
+
     while (!event)
     {
         while (wl_display_prepare_read(_glfw.wl.display) != 0)
@@ -1128,9 +1641,24 @@ static void handleEvents(double* timeout)
             return;
         }
 
-        if (!_glfwPollPOSIX(fds, sizeof(fds) / sizeof(fds[0]), timeout))
+        // Wait for room in the socket if the compositor is applying backpressure
+        if (_glfw.wl.flushPending)
+            fds[0].events = POLLIN | POLLOUT;
+        else
+            fds[0].events = POLLIN;
+
+        nfds_t count = 5;
+
+#if defined(GLFW_BUILD_LINUX_JOYSTICK)
+        // The set of joystick devices may have changed since the last wait
+        if (_glfw.joysticksInitialized)
+            count += _glfwGetJoystickPollFdsLinux(fds + count);
+#endif
+
+        if (!_glfwPollPOSIX(fds, count, timeout))
         {
             wl_display_cancel_read(_glfw.wl.display);
+            expireClipboardRequest();
             return;
         }
 
@@ -1149,6 +1677,14 @@ static void handleEvents(double* timeout)
 
             if (read(_glfw.wl.keyRepeatTimerfd, &repeats, sizeof(repeats)) == 8)
             {
+                // After a stall, drop the repeats beyond the window's limit
+                _GLFWwindow* window = _glfw.wl.keyboardFocus;
+                if (window && window->keyRepeatLimit > 0 &&
+                    repeats > (uint64_t) window->keyRepeatLimit)
+                {
+                    repeats = window->keyRepeatLimit;
+                }
+
                 for (uint64_t i = 0; i < repeats; i++)
                 {
                     _glfwInputKey(_glfw.wl.keyboardFocus,
@@ -1176,6 +1712,35 @@ static void handleEvents(double* timeout)
 
         if (fds[3].revents & POLLIN)
             libdecor_dispatch(_glfw.wl.libdecor.context, 0);
+
+        if (fds[4].revents & (POLLIN | POLLHUP | POLLERR))
+        {
+            if (readClipboardRequest())
+                event = GLFW_TRUE;
+
+            fds[4].fd = _glfw.wl.clipboardRequest.fd;
+        }
+
+#if defined(GLFW_BUILD_LINUX_JOYSTICK)
+        for (nfds_t i = 5;  i < count;  i++)
+        {
+            // Joystick disconnection is reported as POLLHUP or POLLERR
+            if (fds[i].revents)
+            {
+                _glfwDetectJoystickConnectionLinux();
+                _glfwPollJoysticksLinux();
+                event = GLFW_TRUE;
+                break;
+            }
+        }
+#endif
+
+        // Steady compositor traffic can keep poll from ever timing out
+        if (expireClipboardRequest())
+        {
+            fds[4].fd = -1;
+            event = GLFW_TRUE;
+        }
     }
 }
 
@@ -1193,8 +1758,9 @@ static char* readDataOfferAsString(struct wl_data_offer* offer, const char* mime
         return NULL;
     }
 
+    // The pipe is read with blocking calls, so the request must be sent first
     wl_data_offer_receive(offer, mimeType, fds[1]);
-    flushDisplay();
+    flushDisplaySync();
     close(fds[1]);
 
     char* string = NULL;
@@ -1243,6 +1809,67 @@ static char* readDataOfferAsString(struct wl_data_offer* offer, const char* mime
     return string;
 }
 
+// Reports the pointer input accumulated since the last frame
+//
+static void flushPointerFrame(void)
+{
+    _GLFWwindow* window = _glfw.wl.pointerFocus;
+    const _GLFWpointerFrameWayland frame = _glfw.wl.pointerFrame;
+    // Wayland scroll events are in pointer motion coordinate space (think two
+    // finger scroll).  The factor 10 is commonly used to convert to "scroll
+    // step means 1.0.
+    const double scrollFactor = 1.0 / 10.0;
+
+    memset(&_glfw.wl.pointerFrame, 0, sizeof(_glfw.wl.pointerFrame));
+
+    if (!window)
+        return;
+
+    if (frame.motion)
+        _glfwInputCursorPos(window, window->wl.cursorPosX, window->wl.cursorPosY);
+
+    for (int i = 0;  i < frame.buttonCount;  i++)
+    {
+        // The window may have been destroyed by a callback
+        if (_glfw.wl.pointerFocus != window)
+            return;
+
+        /* Makes left, right and middle 0, 1 and 2. Overall order follows evdev
+         * codes. */
+        _glfwInputMouseClick(window,
+                             frame.buttons[i].button - BTN_LEFT,
+                             frame.buttons[i].state == WL_POINTER_BUTTON_STATE_PRESSED
+                                    ? GLFW_PRESS
+                                    : GLFW_RELEASE,
+                             _glfw.wl.xkb.modifiers);
+    }
+
+    if (frame.scrolled && _glfw.wl.pointerFocus == window)
+    {
+        double x, y;
+
+        if (frame.steppedX)
+            x = -frame.steps120X / 120.0;
+        else
+            x = -frame.scrollX * scrollFactor;
+
+        if (frame.steppedY)
+            y = -frame.steps120Y / 120.0;
+        else
+            y = -frame.scrollY * scrollFactor;
+
+        _glfwInputScroll(window, x, y);
+    }
+}
+
+// Reports pointer input at once if the compositor does not send frames
+//
+static void completePointerEvent(struct wl_pointer* pointer)
+{
+    if (wl_pointer_get_version(pointer) < WL_POINTER_FRAME_SINCE_VERSION)
+        flushPointerFrame();
+}
+
 static void pointerHandleEnter(void* userData,
                                struct wl_pointer* pointer,
                                uint32_t serial,
@@ -1295,6 +1922,14 @@ static void pointerHandleLeave(void* userData,
     if (!window)
         return;
 
+    // Input from before the leave event still belongs to the window
+    flushPointerFrame();
+
+    // The window may have been destroyed by a callback
+    window = _glfw.wl.pointerFocus;
+    if (!window)
+        return;
+
     window->wl.hovered = GLFW_FALSE;
 
     _glfw.wl.serial = serial;
@@ -1303,15 +1938,59 @@ static void pointerHandleLeave(void* userData,
     _glfwInputCursorEnter(window, GLFW_FALSE);
 }
 
+#if defined(HAVE_CURSOR_SHAPE_V1)
+// The shapes of the cursor names used by the fallback decorations
+//
+static const struct
+{
+    const char* name;
+    uint32_t shape;
+} decorationCursorShapes[] =
+{
+    { "left_ptr", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_DEFAULT },
+    { "n-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_N_RESIZE },
+    { "nw-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_NW_RESIZE },
+    { "ne-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_NE_RESIZE },
+    { "w-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_W_RESIZE },
+    { "e-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_E_RESIZE },
+    { "sw-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_SW_RESIZE },
+    { "se-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_SE_RESIZE },
+    { "s-resize", WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_S_RESIZE }
+};
+#endif
+
 static void setCursor(_GLFWwindow* window, const char* name)
 {
     struct wl_buffer* buffer;
     struct wl_cursor* cursor;
     struct wl_cursor_image* image;
     struct wl_surface* surface = _glfw.wl.cursorSurface;
-    struct wl_cursor_theme* theme = _glfw.wl.cursorTheme;
+    struct wl_cursor_theme* theme;
     int scale = 1;
 
+#if defined(HAVE_CURSOR_SHAPE_V1)
+    if (_glfw.wl.cursorShapeManager)
+    {
+        const size_t count = sizeof(decorationCursorShapes) /
+                             sizeof(decorationCursorShapes[0]);
+
+        for (size_t i = 0;  i < count;  i++)
+        {
+            if (strcmp(decorationCursorShapes[i].name, name) == 0)
+            {
+                setCursorShape(decorationCursorShapes[i].shape);
+                _glfw.wl.cursorPreviousName = name;
+                return;
+            }
+        }
+    }
+#endif
+
+    if (!loadCursorTheme())
+        return;
+
+    theme = _glfw.wl.cursorTheme;
+
     if (window->wl.contentScale > 1 && _glfw.wl.cursorThemeHiDPI)
     {
         // We only support up to scale=2 for now, since libwayland-cursor
@@ -1372,7 +2051,8 @@ static void pointerHandleMotion(void* userData,
     {
         case GLFW_MAIN_WINDOW:
             _glfw.wl.cursorPreviousName = NULL;
-            _glfwInputCursorPos(window, x, y);
+            _glfw.wl.pointerFrame.motion = GLFW_TRUE;
+            completePointerEvent(pointer);
             return;
         case GLFW_TOP_DECORATION:
             if (y < GLFW_BORDER_SIZE)
@@ -1415,7 +2095,6 @@ static void pointerHandleButton(void* userData,
                                 uint32_t state)
 {
     _GLFWwindow* window = _glfw.wl.pointerFocus;
-    int glfwButton;
     uint32_t edges = XDG_TOPLEVEL_RESIZE_EDGE_NONE;
 
     if (!window)
@@ -1481,16 +2160,16 @@ static void pointerHandleButton(void* userData,
 
     _glfw.wl.serial = serial;
 
-    /* Makes left, right and middle 0, 1 and 2. Overall order follows evdev
-     * codes. */
-    glfwButton = button - BTN_LEFT;
+    _GLFWpointerFrameWayland* frame = &_glfw.wl.pointerFrame;
+    const int maxButtons = sizeof(frame->buttons) / sizeof(frame->buttons[0]);
+    if (frame->buttonCount == maxButtons)
+        flushPointerFrame();
 
-    _glfwInputMouseClick(window,
-                         glfwButton,
-                         state == WL_POINTER_BUTTON_STATE_PRESSED
-                                ? GLFW_PRESS
-                                : GLFW_RELEASE,
-                         _glfw.wl.xkb.modifiers);
+    frame->buttons[frame->buttonCount].button = button;
+    frame->buttons[frame->buttonCount].state = state;
+    frame->buttonCount++;
+
+    completePointerEvent(pointer);
 }
 
 static void pointerHandleAxis(void* userData,
@@ -1500,11 +2179,6 @@ static void pointerHandleAxis(void* userData,
                               wl_fixed_t value)
 {
     _GLFWwindow* window = _glfw.wl.pointerFocus;
-    double x = 0.0, y = 0.0;
-    // Wayland scroll events are in pointer motion coordinate space (think two
-    // finger scroll).  The factor 10 is commonly used to convert to "scroll
-    // step means 1.0.
-    const double scrollFactor = 1.0 / 10.0;
 
     if (!window)
         return;
@@ -1513,12 +2187,65 @@ static void pointerHandleAxis(void* userData,
            axis == WL_POINTER_AXIS_VERTICAL_SCROLL);
 
     if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
-        x = -wl_fixed_to_double(value) * scrollFactor;
+        _glfw.wl.pointerFrame.scrollX += wl_fixed_to_double(value);
+    else if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL)
+        _glfw.wl.pointerFrame.scrollY += wl_fixed_to_double(value);
+
+    _glfw.wl.pointerFrame.scrolled = GLFW_TRUE;
+    completePointerEvent(pointer);
+}
+
+static void pointerHandleFrame(void* userData, struct wl_pointer* pointer)
+{
+    flushPointerFrame();
+}
+
+static void pointerHandleAxisSource(void* userData,
+                                    struct wl_pointer* pointer,
+                                    uint32_t source)
+{
+}
+
+static void pointerHandleAxisStop(void* userData,
+                                  struct wl_pointer* pointer,
+                                  uint32_t time,
+                                  uint32_t axis)
+{
+}
+
+// Adds wheel steps, in 120ths of a step, to the current pointer frame
+//
+static void addPointerSteps(uint32_t axis, int32_t steps120)
+{
+    if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
+    {
+        _glfw.wl.pointerFrame.steps120X += steps120;
+        _glfw.wl.pointerFrame.steppedX = GLFW_TRUE;
+    }
     else if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL)
-        y = -wl_fixed_to_double(value) * scrollFactor;
+    {
+        _glfw.wl.pointerFrame.steps120Y += steps120;
+        _glfw.wl.pointerFrame.steppedY = GLFW_TRUE;
+    }
+}
+
+static void pointerHandleAxisDiscrete(void* userData,
+                                      struct wl_pointer* pointer,
+                                      uint32_t axis,
+                                      int32_t discrete)
+{
+    addPointerSteps(axis, discrete * 120);
+}
 
-    _glfwInputScroll(window, x, y);
+#if defined(WL_POINTER_AXIS_VALUE120_SINCE_VERSION)
+static void pointerHandleAxisValue120(void* userData,
+                                      struct wl_pointer* pointer,
+                                      uint32_t axis,
+                                      int32_t value120)
+{
+    addPointerSteps(axis, value120);
 }
+#endif
 
 static const struct wl_pointer_listener pointerListener =
 {
@@ -1527,8 +2254,30 @@ static const struct wl_pointer_listener pointerListener =
     pointerHandleMotion,
     pointerHandleButton,
     pointerHandleAxis,
+    pointerHandleFrame,
+    pointerHandleAxisSource,
+    pointerHandleAxisStop,
+    pointerHandleAxisDiscrete,
+#if defined(WL_POINTER_AXIS_VALUE120_SINCE_VERSION)
+    pointerHandleAxisValue120,
+#endif
 };
 
+// Returns the 64-bit FNV-1a hash of the specified keymap text
+//
+static uint64_t hashKeymap(const char* text, size_t size)
+{
+    uint64_t hash = 14695981039346656037u;
+
+    for (size_t i = 0;  i < size;  i++)
+    {
+        hash ^= (unsigned char) text[i];
+        hash *= 1099511628211u;
+    }
+
+    return hash;
+}
+
 static void keyboardHandleKeymap(void* userData,
                                  struct wl_keyboard* keyboard,
                                  uint32_t format,
@@ -1542,6 +2291,7 @@ static void keyboardHandleKeymap(void* userData,
 
     char* mapStr;
     const char* locale;
+    uint64_t hash;
 
     if (format != WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1)
     {
@@ -1549,33 +2299,62 @@ static void keyboardHandleKeymap(void* userData,
         return;
     }
 
-    mapStr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    // Version 7 and later of wl_keyboard require a private mapping
+    mapStr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
     if (mapStr == MAP_FAILED) {
         close(fd);
         return;
     }
 
-    keymap = xkb_keymap_new_from_string(_glfw.wl.xkb.context,
-                                        mapStr,
-                                        XKB_KEYMAP_FORMAT_TEXT_V1,
-                                        0);
-    munmap(mapStr, size);
-    close(fd);
+    hash = hashKeymap(mapStr, size);
 
-    if (!keymap)
+    // Some compositors resend an identical keymap on every seat capability
+    // change or window focus, so only compile keymaps we have not seen last
+    if (_glfw.wl.xkb.keymap &&
+        _glfw.wl.xkb.keymapSize == size &&
+        _glfw.wl.xkb.keymapHash == hash)
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to compile keymap");
-        return;
+        munmap(mapStr, size);
+        close(fd);
     }
-
-    state = xkb_state_new(keymap);
-    if (!state)
+    else
     {
-        _glfwInputError(GLFW_PLATFORM_ERROR,
-                        "Wayland: Failed to create XKB state");
-        xkb_keymap_unref(keymap);
-        return;
+        keymap = xkb_keymap_new_from_string(_glfw.wl.xkb.context,
+                                            mapStr,
+                                            XKB_KEYMAP_FORMAT_TEXT_V1,
+                                            0);
+        munmap(mapStr, size);
+        close(fd);
+
+        if (!keymap)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to compile keymap");
+            return;
+        }
+
+        state = xkb_state_new(keymap);
+        if (!state)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Wayland: Failed to create XKB state");
+            xkb_keymap_unref(keymap);
+            return;
+        }
+
+        xkb_keymap_unref(_glfw.wl.xkb.keymap);
+        xkb_state_unref(_glfw.wl.xkb.state);
+        _glfw.wl.xkb.keymap = keymap;
+        _glfw.wl.xkb.state = state;
+        _glfw.wl.xkb.keymapSize = size;
+        _glfw.wl.xkb.keymapHash = hash;
+
+        _glfw.wl.xkb.controlIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Control");
+        _glfw.wl.xkb.altIndex      = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod1");
+        _glfw.wl.xkb.shiftIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Shift");
+        _glfw.wl.xkb.superIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod4");
+        _glfw.wl.xkb.capsLockIndex = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Lock");
+        _glfw.wl.xkb.numLockIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod2");
     }
 
     // Look up the preferred locale, falling back to "C" as default.
@@ -1587,6 +2366,16 @@ static void keyboardHandleKeymap(void* userData,
     if (!locale)
         locale = "C";
 
+    // The compose table only depends on the locale, not on the keymap
+    if (_glfw.wl.xkb.composeLocale &&
+        strcmp(_glfw.wl.xkb.composeLocale, locale) == 0)
+    {
+        return;
+    }
+
+    _glfw_free(_glfw.wl.xkb.composeLocale);
+    _glfw.wl.xkb.composeLocale = _glfw_strdup(locale);
+
     composeTable =
         xkb_compose_table_new_from_locale(_glfw.wl.xkb.context, locale,
                                           XKB_COMPOSE_COMPILE_NO_FLAGS);
@@ -1596,7 +2385,12 @@ static void keyboardHandleKeymap(void* userData,
             xkb_compose_state_new(composeTable, XKB_COMPOSE_STATE_NO_FLAGS);
         xkb_compose_table_unref(composeTable);
         if (composeState)
+        {
+            if (_glfw.wl.xkb.composeState)
+                xkb_compose_state_unref(_glfw.wl.xkb.composeState);
+
             _glfw.wl.xkb.composeState = composeState;
+        }
         else
             _glfwInputError(GLFW_PLATFORM_ERROR,
                             "Wayland: Failed to create XKB compose state");
@@ -1606,18 +2400,6 @@ static void keyboardHandleKeymap(void* userData,
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Failed to create XKB compose table");
     }
-
-    xkb_keymap_unref(_glfw.wl.xkb.keymap);
-    xkb_state_unref(_glfw.wl.xkb.state);
-    _glfw.wl.xkb.keymap = keymap;
-    _glfw.wl.xkb.state = state;
-
-    _glfw.wl.xkb.controlIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Control");
-    _glfw.wl.xkb.altIndex      = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod1");
-    _glfw.wl.xkb.shiftIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Shift");
-    _glfw.wl.xkb.superIndex    = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod4");
-    _glfw.wl.xkb.capsLockIndex = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Lock");
-    _glfw.wl.xkb.numLockIndex  = xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Mod2");
 }
 
 static void keyboardHandleEnter(void* userData,
@@ -1790,8 +2572,18 @@ static void seatHandleCapabilities(void* userData,
     }
     else if (!(caps & WL_SEAT_CAPABILITY_POINTER) && _glfw.wl.pointer)
     {
+#if defined(HAVE_CURSOR_SHAPE_V1)
+        if (_glfw.wl.cursorShapeDevice)
+        {
+            wp_cursor_shape_device_v1_destroy(_glfw.wl.cursorShapeDevice);
+            _glfw.wl.cursorShapeDevice = NULL;
+        }
+#endif
+
         wl_pointer_destroy(_glfw.wl.pointer);
         _glfw.wl.pointer = NULL;
+
+        memset(&_glfw.wl.pointerFrame, 0, sizeof(_glfw.wl.pointerFrame));
     }
 
     if ((caps & WL_SEAT_CAPABILITY_KEYBOARD) && !_glfw.wl.keyboard)
@@ -2049,6 +2841,9 @@ GLFWbool _glfwCreateWindowWayland(_GLFWwindow* window,
     if (wndconfig->mousePassthrough)
         _glfwSetWindowMousePassthroughWayland(window, GLFW_TRUE);
 
+    if (wndconfig->asyncPresentation)
+        _glfwSetWindowAsyncPresentationWayland(window, GLFW_TRUE);
+
     if (window->monitor || wndconfig->visible)
     {
         if (!createShellObjects(window))
@@ -2083,12 +2878,30 @@ void _glfwDestroyWindowWayland(_GLFWwindow* window)
 
     destroyShellObjects(window);
 
-    if (window->wl.decorations.buffer)
-        wl_buffer_destroy(window->wl.decorations.buffer);
-
     if (window->wl.egl.window)
         wl_egl_window_destroy(window->wl.egl.window);
 
+#if defined(HAVE_FRACTIONAL_SCALE_V1)
+    if (window->wl.fractionalScale)
+        wp_fractional_scale_v1_destroy(window->wl.fractionalScale);
+#endif
+
+#if defined(HAVE_TEARING_CONTROL_V1)
+    if (window->wl.tearingControl)
+        wp_tearing_control_v1_destroy(window->wl.tearingControl);
+#endif
+
+    if (window->wl.scalingViewport)
+        wp_viewport_destroy(window->wl.scalingViewport);
+
+    if (window->wl.frameCallback)
+        wl_callback_destroy(window->wl.frameCallback);
+
+    for (int i = 0; i < window->wl.feedbackCount; i++)
+        wp_presentation_feedback_destroy(window->wl.feedbacks[i]);
+
+    _glfw_free(window->wl.feedbacks);
+
     if (window->wl.surface)
         wl_surface_destroy(window->wl.surface);
 
@@ -2251,11 +3064,13 @@ void _glfwSetWindowAspectRatioWayland(_GLFWwindow* window, int numer, int denom)
 
 void _glfwGetFramebufferSizeWayland(_GLFWwindow* window, int* width, int* height)
 {
-    _glfwGetWindowSizeWayland(window, width, height);
+    int fbWidth, fbHeight;
+    getFramebufferSize(window, &fbWidth, &fbHeight);
+
     if (width)
-        *width *= window->wl.contentScale;
+        *width = fbWidth;
     if (height)
-        *height *= window->wl.contentScale;
+        *height = fbHeight;
 }
 
 void _glfwGetWindowFrameSizeWayland(_GLFWwindow* window,
@@ -2278,10 +3093,14 @@ void _glfwGetWindowFrameSizeWayland(_GLFWwindow* window,
 void _glfwGetWindowContentScaleWayland(_GLFWwindow* window,
                                        float* xscale, float* yscale)
 {
+    float scale = (float) window->wl.contentScale;
+    if (window->wl.fractionalScale)
+        scale = window->wl.scalingNumerator / 120.f;
+
     if (xscale)
-        *xscale = (float) window->wl.contentScale;
+        *xscale = scale;
     if (yscale)
-        *yscale = (float) window->wl.contentScale;
+        *yscale = scale;
 }
 
 void _glfwIconifyWindowWayland(_GLFWwindow* window)
@@ -2417,6 +3236,11 @@ GLFWbool _glfwFramebufferTransparentWayland(_GLFWwindow* window)
     return window->wl.transparent;
 }
 
+GLFWbool _glfwWindowAsyncPresentationWayland(_GLFWwindow* window)
+{
+    return window->wl.asyncPresentation;
+}
+
 void _glfwSetWindowResizableWayland(_GLFWwindow* window, GLFWbool enabled)
 {
     if (window->wl.libdecor.frame)
@@ -2484,6 +3308,52 @@ void _glfwSetWindowMousePassthroughWayland(_GLFWwindow* window, GLFWbool enabled
         wl_surface_set_input_region(window->wl.surface, 0);
 }
 
+void _glfwSetWindowAsyncPresentationWayland(_GLFWwindow* window, GLFWbool enabled)
+{
+#if defined(HAVE_TEARING_CONTROL_V1)
+    // Without the protocol the compositor always synchronizes presentation
+    if (!_glfw.wl.tearingControlManager)
+        return;
+
+    if (!window->wl.tearingControl)
+    {
+        window->wl.tearingControl =
+            wp_tearing_control_manager_v1_get_tearing_control(
+                _glfw.wl.tearingControlManager,
+                window->wl.surface);
+    }
+
+    // The hint is double-buffered and takes effect at the next buffer swap
+    if (enabled)
+    {
+        wp_tearing_control_v1_set_presentation_hint(window->wl.tearingControl,
+            WP_TEARING_CONTROL_V1_PRESENTATION_HINT_ASYNC);
+    }
+    else
+    {
+        wp_tearing_control_v1_set_presentation_hint(window->wl.tearingControl,
+            WP_TEARING_CONTROL_V1_PRESENTATION_HINT_VSYNC);
+    }
+
+    window->wl.asyncPresentation = enabled;
+#endif
+}
+
+void _glfwUpdateWindowEventsWayland(_GLFWwindow* window)
+{
+    // NOTE: Wayland input events are sent per seat rather than per surface and
+    //       listeners cannot be removed, so there is nothing to update
+}
+
+GLFWbool _glfwWindowReadyForFrameWayland(_GLFWwindow* window)
+{
+    // Frame callbacks are only requested once the application asks for them
+    // NOTE: They are requested when swapping EGL buffers, so windows without
+    //       an EGL context are always ready
+    window->wl.frameTracking = GLFW_TRUE;
+    return window->wl.frameCallback == NULL;
+}
+
 float _glfwGetWindowOpacityWayland(_GLFWwindow* window)
 {
     return 1.f;
@@ -2523,8 +3393,10 @@ void _glfwWaitEventsTimeoutWayland(double timeout)
 
 void _glfwPostEmptyEventWayland(void)
 {
+    // This may be called from any thread, which cannot rely on the main thread
+    // to finish the flush
     wl_display_sync(_glfw.wl.display);
-    flushDisplay();
+    flushDisplaySync();
 }
 
 void _glfwGetCursorPosWayland(_GLFWwindow* window, double* xpos, double* ypos)
@@ -2625,6 +3497,51 @@ GLFWbool _glfwCreateStandardCursorWayland(_GLFWcursor* cursor, int shape)
 {
     const char* name = NULL;
 
+#if defined(HAVE_CURSOR_SHAPE_V1)
+    // The compositor draws named shapes itself, so no theme is needed
+    if (_glfw.wl.cursorShapeManager)
+    {
+        switch (shape)
+        {
+            case GLFW_ARROW_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_DEFAULT;
+                break;
+            case GLFW_IBEAM_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_TEXT;
+                break;
+            case GLFW_CROSSHAIR_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_CROSSHAIR;
+                break;
+            case GLFW_POINTING_HAND_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_POINTER;
+                break;
+            case GLFW_RESIZE_EW_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_EW_RESIZE;
+                break;
+            case GLFW_RESIZE_NS_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_NS_RESIZE;
+                break;
+            case GLFW_RESIZE_NWSE_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_NWSE_RESIZE;
+                break;
+            case GLFW_RESIZE_NESW_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_NESW_RESIZE;
+                break;
+            case GLFW_RESIZE_ALL_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_ALL_SCROLL;
+                break;
+            case GLFW_NOT_ALLOWED_CURSOR:
+                cursor->wl.shape = WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_NOT_ALLOWED;
+                break;
+        }
+
+        return GLFW_TRUE;
+    }
+#endif
+
+    if (!loadCursorTheme())
+        return GLFW_FALSE;
+
     // Try the XDG names first
     switch (shape)
     {
@@ -2729,7 +3646,7 @@ void _glfwDestroyCursorWayland(_GLFWcursor* cursor)
         return;
 
     if (cursor->wl.buffer)
-        wl_buffer_destroy(cursor->wl.buffer);
+        destroyShmBuffer(cursor->wl.buffer);
 }
 
 static void relativePointerHandleRelativeMotion(void* userData,
@@ -2902,8 +3819,15 @@ void _glfwSetCursorWayland(_GLFWwindow* window, _GLFWcursor* cursor)
     {
         if (cursor)
             setCursorImage(window, &cursor->wl);
+#if defined(HAVE_CURSOR_SHAPE_V1)
+        else if (_glfw.wl.cursorShapeManager)
+            setCursorShape(WP_CURSOR_SHAPE_DEVICE_V1_SHAPE_DEFAULT);
+#endif
         else
         {
+            if (!loadCursorTheme())
+                return;
+
             struct wl_cursor* defaultCursor =
                 wl_cursor_theme_get_cursor(_glfw.wl.cursorTheme, "left_ptr");
             if (!defaultCursor)
@@ -3060,6 +3984,46 @@ const char* _glfwGetClipboardStringWayland(void)
     return _glfw.wl.clipboardString;
 }
 
+void _glfwRequestClipboardStringWayland(void)
+{
+    if (!_glfw.wl.selectionOffer)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "Wayland: No clipboard data available");
+        _glfwInputClipboardString(NULL);
+        return;
+    }
+
+    if (_glfw.wl.selectionSource)
+    {
+        _glfwInputClipboardString(_glfw.wl.clipboardString);
+        return;
+    }
+
+    int fds[2];
+
+    if (pipe2(fds, O_CLOEXEC) == -1)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Wayland: Failed to create pipe for data offer: %s",
+                        strerror(errno));
+        _glfwInputClipboardString(NULL);
+        return;
+    }
+
+    // Only our end is non-blocking, the write end belongs to the data source
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+    wl_data_offer_receive(_glfw.wl.selectionOffer,
+                          "text/plain;charset=utf-8",
+                          fds[1]);
+    flushDisplay();
+    close(fds[1]);
+
+    _glfw.wl.clipboardRequest.fd = fds[0];
+    extendClipboardRequest();
+}
+
 EGLenum _glfwGetEGLPlatformWayland(EGLint** attribs)
 {
     if (_glfw.egl.EXT_platform_base && _glfw.egl.EXT_platform_wayland)
@@ -3175,5 +4139,19 @@ GLFWAPI struct wl_surface* glfwGetWaylandWindow(GLFWwindow* handle)
     return window->wl.surface;
 }
 
+GLFWAPI int glfwGetWaylandFlushPending(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (_glfw.platform.platformID != GLFW_PLATFORM_WAYLAND)
+    {
+        _glfwInputError(GLFW_PLATFORM_UNAVAILABLE,
+                        "Wayland: Platform not initialized");
+        return GLFW_FALSE;
+    }
+
+    return _glfw.wl.flushPending;
+}
+
 #endif // _GLFW_WAYLAND
 
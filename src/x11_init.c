@@ -489,8 +489,12 @@ static void inputMethodInstantiateCallback(Display* display,
         callback.client_data = NULL;
         XSetIMValues(_glfw.x11.im, XNDestroyCallback, &callback, NULL);
 
+        // Input contexts are only created for windows that receive text input
         for (_GLFWwindow* window = _glfw.windowListHead;  window;  window = window->next)
-            _glfwCreateInputContextX11(window);
+        {
+            if (window->callbacks.character || window->callbacks.charmods)
+                _glfwCreateInputContextX11(window);
+        }
     }
 }
 
@@ -920,6 +924,8 @@ static GLFWbool initExtensions(void)
     // Custom selection property atom
     _glfw.x11.GLFW_SELECTION =
         XInternAtom(_glfw.x11.display, "GLFW_SELECTION", False);
+    _glfw.x11.GLFW_CLIPBOARD_REQUEST =
+        XInternAtom(_glfw.x11.display, "GLFW_CLIPBOARD_REQUEST", False);
 
     // ICCCM standard clipboard atoms
     _glfw.x11.TARGETS = XInternAtom(_glfw.x11.display, "TARGETS", False);
@@ -1184,18 +1190,23 @@ GLFWbool _glfwConnectX11(int platformID, _GLFWplatform* platform)
         _glfwGetKeyScancodeX11,
         _glfwSetClipboardStringX11,
         _glfwGetClipboardStringX11,
+        _glfwRequestClipboardStringX11,
 #if defined(GLFW_BUILD_LINUX_JOYSTICK)
         _glfwInitJoysticksLinux,
         _glfwTerminateJoysticksLinux,
         _glfwPollJoystickLinux,
+        _glfwPollJoysticksLinux,
         _glfwGetMappingNameLinux,
         _glfwUpdateGamepadGUIDLinux,
+        _glfwGetGamepadSnapshotLinux,
 #else
         _glfwInitJoysticksNull,
         _glfwTerminateJoysticksNull,
         _glfwPollJoystickNull,
+        _glfwPollJoysticksNull,
         _glfwGetMappingNameNull,
         _glfwUpdateGamepadGUIDNull,
+        _glfwGetGamepadSnapshotNull,
 #endif
         _glfwFreeMonitorX11,
         _glfwGetMonitorPosX11,
@@ -1232,12 +1243,16 @@ GLFWbool _glfwConnectX11(int platformID, _GLFWplatform* platform)
         _glfwWindowMaximizedX11,
         _glfwWindowHoveredX11,
         _glfwFramebufferTransparentX11,
+        _glfwWindowAsyncPresentationX11,
         _glfwGetWindowOpacityX11,
         _glfwSetWindowResizableX11,
         _glfwSetWindowDecoratedX11,
         _glfwSetWindowFloatingX11,
         _glfwSetWindowOpacityX11,
         _glfwSetWindowMousePassthroughX11,
+        _glfwSetWindowAsyncPresentationX11,
+        _glfwUpdateWindowEventsX11,
+        _glfwWindowReadyForFrameX11,
         _glfwPollEventsX11,
         _glfwWaitEventsX11,
         _glfwWaitEventsTimeoutX11,
@@ -1417,6 +1432,8 @@ int _glfwInitX11(void)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XMapRaised");
     _glfw.x11.xlib.MapWindow = (PFN_XMapWindow)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XMapWindow");
+    _glfw.x11.xlib.MaxRequestSize = (PFN_XMaxRequestSize)
+        _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XMaxRequestSize");
     _glfw.x11.xlib.MoveResizeWindow = (PFN_XMoveResizeWindow)
         _glfwPlatformGetModuleSymbol(_glfw.x11.xlib.handle, "XMoveResizeWindow");
     _glfw.x11.xlib.MoveWindow = (PFN_XMoveWindow)
@@ -1527,6 +1544,13 @@ int _glfwInitX11(void)
     _glfw.x11.root = RootWindow(_glfw.x11.display, _glfw.x11.screen);
     _glfw.x11.context = XUniqueContext();
 
+    // Selection data larger than a single request is sent with INCR
+    // The margin leaves room for the ChangeProperty request header
+    const int chunkSize = _glfw.hints.init.x11.selectionChunkSize;
+    _glfw.x11.incr.chunkSize = XMaxRequestSize(_glfw.x11.display) * 4 - 100;
+    if (chunkSize > 0 && (size_t) chunkSize < _glfw.x11.incr.chunkSize)
+        _glfw.x11.incr.chunkSize = chunkSize;
+
     getSystemContentScale(&_glfw.x11.contentScaleX, &_glfw.x11.contentScaleY);
 
     if (!createEmptyEventPipe())
@@ -1536,8 +1560,18 @@ int _glfwInitX11(void)
         return GLFW_FALSE;
 
     _glfw.x11.helperWindowHandle = createHelperWindow();
+    _glfw.x11.clipboardRequest.window = createHelperWindow();
     _glfw.x11.hiddenCursorHandle = createHiddenCursor();
 
+    if (_glfw.x11.NET_WORKAREA && _glfw.x11.NET_CURRENT_DESKTOP)
+    {
+        // Track the EWMH work area properties on the root window so that work
+        // area queries do not need to round-trip to the server
+        XSelectInput(_glfw.x11.display, _glfw.x11.root, PropertyChangeMask);
+        _glfwUpdateWorkareaX11(_glfw.x11.NET_WORKAREA);
+        _glfwUpdateWorkareaX11(_glfw.x11.NET_CURRENT_DESKTOP);
+    }
+
     if (XSupportsLocale() && _glfw.x11.xlib.utf8)
     {
         XSetLocaleModifiers("");
@@ -1567,12 +1601,31 @@ void _glfwTerminateX11(void)
         _glfw.x11.helperWindowHandle = None;
     }
 
+    if (_glfw.x11.clipboardRequest.window)
+        XDestroyWindow(_glfw.x11.display, _glfw.x11.clipboardRequest.window);
+
     if (_glfw.x11.hiddenCursorHandle)
     {
         XFreeCursor(_glfw.x11.display, _glfw.x11.hiddenCursorHandle);
         _glfw.x11.hiddenCursorHandle = (Cursor) 0;
     }
 
+    if (_glfw.x11.workarea.extents)
+    {
+        XFree(_glfw.x11.workarea.extents);
+        _glfw.x11.workarea.extents = NULL;
+    }
+
+    for (int i = 0;  i < _glfw.x11.incr.count;  i++)
+        _glfw_free(_glfw.x11.incr.transfers[i].data);
+
+    _glfw_free(_glfw.x11.incr.transfers);
+    _glfw.x11.incr.transfers = NULL;
+    _glfw.x11.incr.count = 0;
+
+    _glfw_free(_glfw.x11.clipboardRequest.string);
+    memset(&_glfw.x11.clipboardRequest, 0, sizeof(_glfw.x11.clipboardRequest));
+
     _glfw_free(_glfw.x11.primarySelectionString);
     _glfw_free(_glfw.x11.clipboardString);
 
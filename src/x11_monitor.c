@@ -307,6 +307,45 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
     }
 }
 
+// Refresh the cached copy of the specified EWMH work area root property
+//
+void _glfwUpdateWorkareaX11(Atom property)
+{
+    if (property == None)
+        return;
+
+    if (property == _glfw.x11.NET_WORKAREA)
+    {
+        if (_glfw.x11.workarea.extents)
+            XFree(_glfw.x11.workarea.extents);
+
+        _glfw.x11.workarea.extents = NULL;
+        _glfw.x11.workarea.extentCount =
+            _glfwGetWindowPropertyX11(_glfw.x11.root,
+                                      _glfw.x11.NET_WORKAREA,
+                                      XA_CARDINAL,
+                                      (unsigned char**) &_glfw.x11.workarea.extents);
+    }
+    else if (property == _glfw.x11.NET_CURRENT_DESKTOP)
+    {
+        unsigned long* desktop = NULL;
+
+        _glfw.x11.workarea.desktopValid = GLFW_FALSE;
+
+        if (_glfwGetWindowPropertyX11(_glfw.x11.root,
+                                      _glfw.x11.NET_CURRENT_DESKTOP,
+                                      XA_CARDINAL,
+                                      (unsigned char**) &desktop) > 0)
+        {
+            _glfw.x11.workarea.desktop = *desktop;
+            _glfw.x11.workarea.desktopValid = GLFW_TRUE;
+        }
+
+        if (desktop)
+            XFree(desktop);
+    }
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -384,51 +423,37 @@ void _glfwGetMonitorWorkareaX11(_GLFWmonitor* monitor,
         areaHeight = DisplayHeight(_glfw.x11.display, _glfw.x11.screen);
     }
 
-    if (_glfw.x11.NET_WORKAREA && _glfw.x11.NET_CURRENT_DESKTOP)
+    // NOTE: The EWMH work area properties are cached and kept up to date by
+    //       PropertyNotify events on the root window (see x11_init.c)
+    if (_glfw.x11.workarea.extentCount >= 4 && _glfw.x11.workarea.desktopValid)
     {
-        Atom* extents = NULL;
-        Atom* desktop = NULL;
-        const unsigned long extentCount =
-            _glfwGetWindowPropertyX11(_glfw.x11.root,
-                                      _glfw.x11.NET_WORKAREA,
-                                      XA_CARDINAL,
-                                      (unsigned char**) &extents);
+        const unsigned long* extents = _glfw.x11.workarea.extents;
+        const unsigned long desktop = _glfw.x11.workarea.desktop;
 
-        if (_glfwGetWindowPropertyX11(_glfw.x11.root,
-                                      _glfw.x11.NET_CURRENT_DESKTOP,
-                                      XA_CARDINAL,
-                                      (unsigned char**) &desktop) > 0)
+        if (desktop < _glfw.x11.workarea.extentCount / 4)
         {
-            if (extentCount >= 4 && *desktop < extentCount / 4)
-            {
-                const int globalX = extents[*desktop * 4 + 0];
-                const int globalY = extents[*desktop * 4 + 1];
-                const int globalWidth  = extents[*desktop * 4 + 2];
-                const int globalHeight = extents[*desktop * 4 + 3];
-
-                if (areaX < globalX)
-                {
-                    areaWidth -= globalX - areaX;
-                    areaX = globalX;
-                }
+            const int globalX = extents[desktop * 4 + 0];
+            const int globalY = extents[desktop * 4 + 1];
+            const int globalWidth  = extents[desktop * 4 + 2];
+            const int globalHeight = extents[desktop * 4 + 3];
 
-                if (areaY < globalY)
-                {
-                    areaHeight -= globalY - areaY;
-                    areaY = globalY;
-                }
+            if (areaX < globalX)
+            {
+                areaWidth -= globalX - areaX;
+                areaX = globalX;
+            }
 
-                if (areaX + areaWidth > globalX + globalWidth)
-                    areaWidth = globalX - areaX + globalWidth;
-                if (areaY + areaHeight > globalY + globalHeight)
-                    areaHeight = globalY - areaY + globalHeight;
+            if (areaY < globalY)
+            {
+                areaHeight -= globalY - areaY;
+                areaY = globalY;
             }
-        }
 
-        if (extents)
-            XFree(extents);
-        if (desktop)
-            XFree(desktop);
+            if (areaX + areaWidth > globalX + globalWidth)
+                areaWidth = globalX - areaX + globalWidth;
+            if (areaY + areaHeight > globalY + globalHeight)
+                areaHeight = globalY - areaY + globalHeight;
+        }
     }
 
     if (xpos)
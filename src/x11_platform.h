@@ -146,6 +146,7 @@ typedef Atom (* PFN_XInternAtom)(Display*,const char*,Bool);
 typedef int (* PFN_XLookupString)(XKeyEvent*,char*,int,KeySym*,XComposeStatus*);
 typedef int (* PFN_XMapRaised)(Display*,Window);
 typedef int (* PFN_XMapWindow)(Display*,Window);
+typedef long (* PFN_XMaxRequestSize)(Display*);
 typedef int (* PFN_XMoveResizeWindow)(Display*,Window,int,int,unsigned int,unsigned int);
 typedef int (* PFN_XMoveWindow)(Display*,Window,int,int);
 typedef int (* PFN_XNextEvent)(Display*,XEvent*);
@@ -247,6 +248,7 @@ typedef void (* PFN_Xutf8SetWMProperties)(Display*,Window,const char*,const char
 #define XLookupString _glfw.x11.xlib.LookupString
 #define XMapRaised _glfw.x11.xlib.MapRaised
 #define XMapWindow _glfw.x11.xlib.MapWindow
+#define XMaxRequestSize _glfw.x11.xlib.MaxRequestSize
 #define XMoveResizeWindow _glfw.x11.xlib.MoveResizeWindow
 #define XMoveWindow _glfw.x11.xlib.MoveWindow
 #define XNextEvent _glfw.x11.xlib.NextEvent
@@ -534,6 +536,11 @@ typedef struct _GLFWwindowX11
     // Whether the visual supports framebuffer transparency
     GLFWbool        transparent;
 
+    // The currently selected core event mask
+    long            eventMask;
+    // Additional events required by the input context
+    unsigned long   filterEvents;
+
     // Cached position and size used to filter out duplicate events
     int             width, height;
     int             xpos, ypos;
@@ -548,6 +555,22 @@ typedef struct _GLFWwindowX11
     Time            keyPressTimes[256];
 } _GLFWwindowX11;
 
+// X11-specific outgoing INCR selection transfer
+//
+typedef struct _GLFWtransferX11
+{
+    Window          requestor;
+    Atom            property;
+    Atom            target;
+    // Copy of the selection data taken when the transfer started
+    char*           data;
+    size_t          size;
+    size_t          offset;
+    // Timer value after which the transfer is abandoned if the requestor has
+    // not asked for the next chunk
+    uint64_t        deadline;
+} _GLFWtransferX11;
+
 // X11-specific global data
 //
 typedef struct _GLFWlibraryX11
@@ -641,6 +664,7 @@ typedef struct _GLFWlibraryX11
     Atom            COMPOUND_STRING;
     Atom            ATOM_PAIR;
     Atom            GLFW_SELECTION;
+    Atom            GLFW_CLIPBOARD_REQUEST;
 
     struct {
         void*       handle;
@@ -693,6 +717,7 @@ typedef struct _GLFWlibraryX11
         PFN_XLookupString LookupString;
         PFN_XMapRaised MapRaised;
         PFN_XMapWindow MapWindow;
+        PFN_XMaxRequestSize MaxRequestSize;
         PFN_XMoveResizeWindow MoveResizeWindow;
         PFN_XMoveWindow MoveWindow;
         PFN_XNextEvent NextEvent;
@@ -802,6 +827,39 @@ typedef struct _GLFWlibraryX11
         Atom        format;
     } xdnd;
 
+    // Root window EWMH properties tracked via PropertyNotify
+    struct {
+        // _NET_WORKAREA extents, four per desktop
+        unsigned long* extents;
+        unsigned long extentCount;
+        // _NET_CURRENT_DESKTOP index
+        unsigned long desktop;
+        GLFWbool    desktopValid;
+    } workarea;
+
+    // Outgoing selection transfers using the INCR mechanism (ICCCM 2.7.2)
+    struct {
+        // Largest number of bytes written to a property in a single request
+        size_t      chunkSize;
+        _GLFWtransferX11* transfers;
+        int         count;
+    } incr;
+
+    // Asynchronous clipboard request started by glfwRequestClipboardString
+    struct {
+        // Requestor window, kept separate from the helper window so that the
+        // synchronous selection transfers never see its notifications
+        Window      window;
+        // The target currently being converted, or None if there is no request
+        Atom        target;
+        // Whether the owner is sending the data with INCR
+        GLFWbool    incr;
+        char*       string;
+        size_t      length;
+        // Timer value after which the request is abandoned
+        uint64_t    deadline;
+    } clipboardRequest;
+
     struct {
         void*       handle;
         PFN_XcursorImageCreate ImageCreate;
@@ -928,12 +986,16 @@ GLFWbool _glfwWindowVisibleX11(_GLFWwindow* window);
 GLFWbool _glfwWindowMaximizedX11(_GLFWwindow* window);
 GLFWbool _glfwWindowHoveredX11(_GLFWwindow* window);
 GLFWbool _glfwFramebufferTransparentX11(_GLFWwindow* window);
+GLFWbool _glfwWindowAsyncPresentationX11(_GLFWwindow* window);
 void _glfwSetWindowResizableX11(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowDecoratedX11(_GLFWwindow* window, GLFWbool enabled);
 void _glfwSetWindowFloatingX11(_GLFWwindow* window, GLFWbool enabled);
 float _glfwGetWindowOpacityX11(_GLFWwindow* window);
 void _glfwSetWindowOpacityX11(_GLFWwindow* window, float opacity);
 void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled);
+void _glfwSetWindowAsyncPresentationX11(_GLFWwindow* window, GLFWbool enabled);
+void _glfwUpdateWindowEventsX11(_GLFWwindow* window);
+GLFWbool _glfwWindowReadyForFrameX11(_GLFWwindow* window);
 
 void _glfwSetRawMouseMotionX11(_GLFWwindow *window, GLFWbool enabled);
 GLFWbool _glfwRawMouseMotionSupportedX11(void);
@@ -954,6 +1016,7 @@ void _glfwDestroyCursorX11(_GLFWcursor* cursor);
 void _glfwSetCursorX11(_GLFWwindow* window, _GLFWcursor* cursor);
 void _glfwSetClipboardStringX11(const char* string);
 const char* _glfwGetClipboardStringX11(void);
+void _glfwRequestClipboardStringX11(void);
 
 EGLenum _glfwGetEGLPlatformX11(EGLint** attribs);
 EGLNativeDisplayType _glfwGetEGLNativeDisplayX11(void);
@@ -973,6 +1036,7 @@ GLFWbool _glfwGetGammaRampX11(_GLFWmonitor* monitor, GLFWgammaramp* ramp);
 void _glfwSetGammaRampX11(_GLFWmonitor* monitor, const GLFWgammaramp* ramp);
 
 void _glfwPollMonitorsX11(void);
+void _glfwUpdateWorkareaX11(Atom property);
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired);
 void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
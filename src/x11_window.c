@@ -82,7 +82,7 @@ static GLFWbool waitForX11Event(double* timeout)
 static GLFWbool waitForAnyEvent(double* timeout)
 {
     nfds_t count = 2;
-    struct pollfd fds[3] =
+    struct pollfd fds[2 + GLFW_JOYSTICK_LAST + 2] =
     {
         { ConnectionNumber(_glfw.x11.display), POLLIN },
         { _glfw.x11.emptyEventPipe[0], POLLIN }
@@ -90,7 +90,7 @@ static GLFWbool waitForAnyEvent(double* timeout)
 
 #if defined(GLFW_BUILD_LINUX_JOYSTICK)
     if (_glfw.joysticksInitialized)
-        fds[count++] = (struct pollfd) { _glfw.linjs.inotify, POLLIN };
+        count += _glfwGetJoystickPollFdsLinux(fds + count);
 #endif
 
     while (!XPending(_glfw.x11.display))
@@ -100,7 +100,8 @@ static GLFWbool waitForAnyEvent(double* timeout)
 
         for (int i = 1; i < count; i++)
         {
-            if (fds[i].revents & POLLIN)
+            // Joystick disconnection is reported as POLLHUP or POLLERR
+            if (fds[i].revents)
                 return GLFW_TRUE;
         }
     }
@@ -182,6 +183,15 @@ static int getWindowState(_GLFWwindow* window)
 //
 static Bool isSelectionEvent(Display* display, XEvent* event, XPointer pointer)
 {
+    if (event->type == PropertyNotify || event->type == DestroyNotify)
+    {
+        for (int i = 0;  i < _glfw.x11.incr.count;  i++)
+        {
+            if (event->xany.window == _glfw.x11.incr.transfers[i].requestor)
+                return True;
+        }
+    }
+
     if (event->xany.window != _glfw.x11.helperWindowHandle)
         return False;
 
@@ -201,6 +211,16 @@ static Bool isFrameExtentsEvent(Display* display, XEvent* event, XPointer pointe
            event->xproperty.atom == _glfw.x11.NET_FRAME_EXTENTS;
 }
 
+// Returns whether it is a SelectionNotify event for a synchronous selection
+// transfer, as opposed to the asynchronous clipboard request, which uses its
+// own requestor window
+//
+static Bool isSelectionNotify(Display* display, XEvent* event, XPointer pointer)
+{
+    return event->type == SelectionNotify &&
+           event->xselection.requestor == _glfw.x11.helperWindowHandle;
+}
+
 // Returns whether it is a property event for the specified selection transfer
 //
 static Bool isSelPropNewValueNotify(Display* display, XEvent* event, XPointer pointer)
@@ -554,6 +574,47 @@ static void enableCursor(_GLFWwindow* window)
     updateCursorImage(window);
 }
 
+// Returns the core event mask required by the window's callbacks and modes
+//
+static long getEventMask(_GLFWwindow* window)
+{
+    // These events are needed to track window and input state that can be
+    // queried regardless of which callbacks are set
+    long mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
+                ButtonPressMask | ButtonReleaseMask | FocusChangeMask |
+                VisibilityChangeMask | PropertyChangeMask;
+
+    // The virtual cursor position of disabled cursor mode is tracked via motion
+    if (window->callbacks.cursorPos || window->cursorMode == GLFW_CURSOR_DISABLED)
+        mask |= PointerMotionMask;
+
+    // Hidden cursor mode needs enter events (see the EnterNotify handler)
+    if (window->callbacks.cursorPos ||
+        window->callbacks.cursorEnter ||
+        window->cursorMode == GLFW_CURSOR_HIDDEN)
+    {
+        mask |= EnterWindowMask | LeaveWindowMask;
+    }
+
+    if (window->callbacks.refresh)
+        mask |= ExposureMask;
+
+    return mask | (long) window->x11.filterEvents;
+}
+
+// Selects only the events needed by the current callbacks and input modes
+// This avoids the server waking up the process for events it would discard
+//
+static void updateEventMask(_GLFWwindow* window)
+{
+    const long mask = getEventMask(window);
+    if (mask == window->x11.eventMask)
+        return;
+
+    XSelectInput(_glfw.x11.display, window->x11.handle, mask);
+    window->x11.eventMask = mask;
+}
+
 // Clear its handle when the input context has been destroyed
 //
 static void inputContextDestroyCallback(XIC ic, XPointer clientData, XPointer callData)
@@ -593,12 +654,11 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
 
     window->x11.transparent = _glfwIsVisualTransparentX11(visual);
 
+    window->x11.eventMask = getEventMask(window);
+
     XSetWindowAttributes wa = { 0 };
     wa.colormap = window->x11.colormap;
-    wa.event_mask = StructureNotifyMask | KeyPressMask | KeyReleaseMask |
-                    PointerMotionMask | ButtonPressMask | ButtonReleaseMask |
-                    ExposureMask | FocusChangeMask | VisibilityChangeMask |
-                    EnterWindowMask | LeaveWindowMask | PropertyChangeMask;
+    wa.event_mask = window->x11.eventMask;
 
     _glfwGrabErrorHandlerX11();
 
@@ -778,9 +838,6 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
                         PropModeReplace, (unsigned char*) &version, 1);
     }
 
-    if (_glfw.x11.im)
-        _glfwCreateInputContextX11(window);
-
     _glfwSetWindowTitleX11(window, wndconfig->title);
     _glfwGetWindowPosX11(window, &window->x11.xpos, &window->x11.ypos);
     _glfwGetWindowSizeX11(window, &window->x11.width, &window->x11.height);
@@ -788,6 +845,200 @@ static GLFWbool createNativeWindow(_GLFWwindow* window,
     return GLFW_TRUE;
 }
 
+// Returns the timer value after which an INCR transfer that makes no progress
+// is abandoned
+//
+static uint64_t getIncrDeadline(void)
+{
+    return _glfwPlatformGetTimerValue() +
+        (uint64_t) (_GLFW_CLIPBOARD_TIMEOUT * _glfwPlatformGetTimerFrequency());
+}
+
+// Writes selection data to the specified property of the requestor, starting
+// an INCR transfer if the data does not fit in a single chunk
+// Returns whether the data or the start of the transfer was written
+//
+static GLFWbool writeSelectionData(Window requestor,
+                                   Atom property,
+                                   Atom target,
+                                   const char* data)
+{
+    const size_t size = strlen(data);
+
+    if (size <= _glfw.x11.incr.chunkSize)
+    {
+        XChangeProperty(_glfw.x11.display,
+                        requestor,
+                        property,
+                        target,
+                        8,
+                        PropModeReplace,
+                        (unsigned char*) data,
+                        size);
+        return GLFW_TRUE;
+    }
+
+    _GLFWtransferX11* transfers =
+        _glfw_realloc(_glfw.x11.incr.transfers,
+                      sizeof(_GLFWtransferX11) * (_glfw.x11.incr.count + 1));
+    if (!transfers)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    _glfw.x11.incr.transfers = transfers;
+
+    _GLFWtransferX11* transfer = transfers + _glfw.x11.incr.count;
+    transfer->data = _glfw_malloc(size);
+    if (!transfer->data)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+        return GLFW_FALSE;
+    }
+
+    memcpy(transfer->data, data, size);
+    transfer->requestor = requestor;
+    transfer->property = property;
+    transfer->target = target;
+    transfer->size = size;
+    transfer->offset = 0;
+    transfer->deadline = getIncrDeadline();
+    _glfw.x11.incr.count++;
+
+    // The requestor deletes the property each time it wants the next chunk
+    XSelectInput(_glfw.x11.display, requestor,
+                 PropertyChangeMask | StructureNotifyMask);
+
+    // The INCR property holds a lower bound on the size of the data
+    const long lowerBound = (long) size;
+    XChangeProperty(_glfw.x11.display,
+                    requestor,
+                    property,
+                    _glfw.x11.INCR,
+                    32,
+                    PropModeReplace,
+                    (unsigned char*) &lowerBound,
+                    1);
+    return GLFW_TRUE;
+}
+
+// Removes the specified INCR transfer and, if it was the last one involving
+// the requestor, stops listening to events from that window
+//
+static void removeIncrTransfer(int index, GLFWbool destroyed)
+{
+    const Window requestor = _glfw.x11.incr.transfers[index].requestor;
+
+    _glfw_free(_glfw.x11.incr.transfers[index].data);
+    _glfw.x11.incr.transfers[index] =
+        _glfw.x11.incr.transfers[--_glfw.x11.incr.count];
+
+    if (destroyed)
+        return;
+
+    for (int i = 0;  i < _glfw.x11.incr.count;  i++)
+    {
+        if (_glfw.x11.incr.transfers[i].requestor == requestor)
+            return;
+    }
+
+    _glfwGrabErrorHandlerX11();
+    XSelectInput(_glfw.x11.display, requestor, NoEventMask);
+    _glfwReleaseErrorHandlerX11();
+}
+
+// Drops INCR transfers whose requestor has stopped asking for chunks without
+// deleting the property or destroying its window
+//
+static void expireIncrTransfers(void)
+{
+    const uint64_t now = _glfwPlatformGetTimerValue();
+
+    for (int i = _glfw.x11.incr.count - 1;  i >= 0;  i--)
+    {
+        if (now >= _glfw.x11.incr.transfers[i].deadline)
+            removeIncrTransfer(i, GLFW_FALSE);
+    }
+}
+
+// Advances any INCR transfer the event belongs to
+// Returns whether the event was consumed
+//
+static GLFWbool handleIncrEvent(const XEvent* event)
+{
+    if (event->type == DestroyNotify)
+    {
+        const Window requestor = event->xdestroywindow.window;
+        GLFWbool found = GLFW_FALSE;
+
+        // The requestor went away, so drop all its transfers
+        for (int i = _glfw.x11.incr.count - 1;  i >= 0;  i--)
+        {
+            if (_glfw.x11.incr.transfers[i].requestor == requestor)
+            {
+                removeIncrTransfer(i, GLFW_TRUE);
+                found = GLFW_TRUE;
+            }
+        }
+
+        return found;
+    }
+
+    if (event->type != PropertyNotify)
+        return GLFW_FALSE;
+
+    GLFWbool found = GLFW_FALSE;
+
+    for (int i = 0;  i < _glfw.x11.incr.count;  i++)
+    {
+        _GLFWtransferX11* transfer = _glfw.x11.incr.transfers + i;
+
+        if (transfer->requestor != event->xproperty.window)
+            continue;
+
+        // A MULTIPLE request may have several transfers to one requestor
+        found = GLFW_TRUE;
+
+        if (transfer->property != event->xproperty.atom)
+            continue;
+
+        if (event->xproperty.state != PropertyDelete)
+        {
+            // This is our own write to the property
+            return GLFW_TRUE;
+        }
+
+        // The requestor has read the previous chunk, so send the next one
+        // A zero-length chunk marks the end of the transfer
+        size_t count = transfer->size - transfer->offset;
+        if (count > _glfw.x11.incr.chunkSize)
+            count = _glfw.x11.incr.chunkSize;
+
+        _glfwGrabErrorHandlerX11();
+        XChangeProperty(_glfw.x11.display,
+                        transfer->requestor,
+                        transfer->property,
+                        transfer->target,
+                        8,
+                        PropModeReplace,
+                        (unsigned char*) transfer->data + transfer->offset,
+                        count);
+        _glfwReleaseErrorHandlerX11();
+
+        transfer->offset += count;
+        transfer->deadline = getIncrDeadline();
+
+        if (count == 0 || _glfw.x11.errorCode != Success)
+            removeIncrTransfer(i, GLFW_FALSE);
+
+        return GLFW_TRUE;
+    }
+
+    // Any other change to a requestor window is of no interest to us
+    return found;
+}
+
 // Set the specified property to the selection converted to the requested target
 //
 static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
@@ -850,19 +1101,16 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
                     break;
             }
 
-            if (j < formatCount)
+            // Conversions that fail are reported by replacing their property
+            // with None (ICCCM section 2.6.2)
+            if (j == formatCount ||
+                !writeSelectionData(request->requestor,
+                                    targets[i + 1],
+                                    targets[i],
+                                    selectionString))
             {
-                XChangeProperty(_glfw.x11.display,
-                                request->requestor,
-                                targets[i + 1],
-                                targets[i],
-                                8,
-                                PropModeReplace,
-                                (unsigned char *) selectionString,
-                                strlen(selectionString));
-            }
-            else
                 targets[i + 1] = None;
+            }
         }
 
         XChangeProperty(_glfw.x11.display,
@@ -904,14 +1152,13 @@ static Atom writeTargetToProperty(const XSelectionRequestEvent* request)
         {
             // The requested target is one we support
 
-            XChangeProperty(_glfw.x11.display,
-                            request->requestor,
-                            request->property,
-                            request->target,
-                            8,
-                            PropModeReplace,
-                            (unsigned char *) selectionString,
-                            strlen(selectionString));
+            if (!writeSelectionData(request->requestor,
+                                    request->property,
+                                    request->target,
+                                    selectionString))
+            {
+                return None;
+            }
 
             return request->property;
         }
@@ -974,10 +1221,10 @@ static const char* getSelectionString(Atom selection)
                           _glfw.x11.helperWindowHandle,
                           CurrentTime);
 
-        while (!XCheckTypedWindowEvent(_glfw.x11.display,
-                                       _glfw.x11.helperWindowHandle,
-                                       SelectionNotify,
-                                       &notification))
+        while (!XCheckIfEvent(_glfw.x11.display,
+                              &notification,
+                              isSelectionNotify,
+                              NULL))
         {
             waitForX11Event(NULL);
         }
@@ -1080,6 +1327,217 @@ static const char* getSelectionString(Atom selection)
     return *selectionString;
 }
 
+// Returns the number of seconds left before the clipboard request times out
+//
+static double getClipboardRequestTimeout(void)
+{
+    const uint64_t now = _glfwPlatformGetTimerValue();
+    if (now >= _glfw.x11.clipboardRequest.deadline)
+        return 0.0;
+
+    return (double) (_glfw.x11.clipboardRequest.deadline - now) /
+        _glfwPlatformGetTimerFrequency();
+}
+
+// Pushes back the clipboard request timeout after progress has been made
+//
+static void extendClipboardRequest(void)
+{
+    _glfw.x11.clipboardRequest.deadline = _glfwPlatformGetTimerValue() +
+        (uint64_t) (_GLFW_CLIPBOARD_TIMEOUT * _glfwPlatformGetTimerFrequency());
+}
+
+// Asks the clipboard owner to convert the clipboard to the specified target
+//
+static void requestClipboardTarget(Atom target)
+{
+    _glfw.x11.clipboardRequest.target = target;
+    _glfw.x11.clipboardRequest.incr = GLFW_FALSE;
+    extendClipboardRequest();
+
+    XConvertSelection(_glfw.x11.display,
+                      _glfw.x11.CLIPBOARD,
+                      target,
+                      _glfw.x11.GLFW_CLIPBOARD_REQUEST,
+                      _glfw.x11.clipboardRequest.window,
+                      CurrentTime);
+    XFlush(_glfw.x11.display);
+}
+
+// Appends received data to the clipboard request string
+//
+static GLFWbool appendClipboardData(const char* data, unsigned long count)
+{
+    const size_t length = _glfw.x11.clipboardRequest.length;
+    char* string = _glfw_realloc(_glfw.x11.clipboardRequest.string,
+                                 length + count + 1);
+    if (!string)
+        return GLFW_FALSE;
+
+    memcpy(string + length, data, count);
+    string[length + count] = '\0';
+
+    _glfw.x11.clipboardRequest.string = string;
+    _glfw.x11.clipboardRequest.length = length + count;
+    return GLFW_TRUE;
+}
+
+// Clears the clipboard request and passes the string, if any, to the callback
+//
+static void finishClipboardRequest(char* string)
+{
+    memset(&_glfw.x11.clipboardRequest, 0, sizeof(_glfw.x11.clipboardRequest));
+
+    _glfwInputClipboardString(string);
+    _glfw_free(string);
+}
+
+// Ends the clipboard request and passes any received string to the callback
+//
+static void endClipboardRequest(GLFWbool success)
+{
+    char* string = _glfw.x11.clipboardRequest.string;
+
+    if (success && string && _glfw.x11.clipboardRequest.target == XA_STRING)
+    {
+        char* converted = convertLatin1toUTF8(string);
+        _glfw_free(string);
+        string = converted;
+    }
+
+    if (!success)
+    {
+        _glfw_free(string);
+        string = NULL;
+    }
+
+    if (!string)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "X11: Failed to convert selection to string");
+    }
+
+    finishClipboardRequest(string);
+}
+
+// Advances the clipboard request using the specified requestor window event
+// Returns whether the event was consumed
+//
+static GLFWbool handleClipboardRequestEvent(const XEvent* event)
+{
+    char* data;
+    Atom actualType;
+    int actualFormat;
+    unsigned long itemCount, bytesAfter;
+
+    if (!_glfw.x11.clipboardRequest.target)
+        return GLFW_FALSE;
+
+    if (event->type == SelectionNotify)
+    {
+        if (event->xselection.selection != _glfw.x11.CLIPBOARD ||
+            event->xselection.target != _glfw.x11.clipboardRequest.target ||
+            (event->xselection.property != None &&
+             event->xselection.property != _glfw.x11.GLFW_CLIPBOARD_REQUEST))
+        {
+            return GLFW_FALSE;
+        }
+
+        if (event->xselection.property == None)
+        {
+            // The owner could not convert to this target, so try the next one
+            if (_glfw.x11.clipboardRequest.target == _glfw.x11.UTF8_STRING)
+                requestClipboardTarget(XA_STRING);
+            else
+                endClipboardRequest(GLFW_FALSE);
+
+            return GLFW_TRUE;
+        }
+
+        XGetWindowProperty(_glfw.x11.display,
+                           _glfw.x11.clipboardRequest.window,
+                           _glfw.x11.GLFW_CLIPBOARD_REQUEST,
+                           0,
+                           LONG_MAX,
+                           True,
+                           AnyPropertyType,
+                           &actualType,
+                           &actualFormat,
+                           &itemCount,
+                           &bytesAfter,
+                           (unsigned char**) &data);
+
+        if (actualType == _glfw.x11.INCR)
+        {
+            // Deleting the property above asked the owner for the first chunk
+            _glfw.x11.clipboardRequest.incr = GLFW_TRUE;
+            extendClipboardRequest();
+        }
+        else if (actualType == _glfw.x11.clipboardRequest.target)
+            endClipboardRequest(appendClipboardData(data, itemCount));
+        else if (actualType == _glfw.x11.UTF8_STRING)
+        {
+            // The owner sent UTF-8 instead of the requested Latin-1, which
+            // needs no conversion
+            _glfw.x11.clipboardRequest.target = _glfw.x11.UTF8_STRING;
+            endClipboardRequest(appendClipboardData(data, itemCount));
+        }
+        else if (_glfw.x11.clipboardRequest.target == _glfw.x11.UTF8_STRING)
+            requestClipboardTarget(XA_STRING);
+        else
+            endClipboardRequest(GLFW_FALSE);
+
+        if (data)
+            XFree(data);
+
+        return GLFW_TRUE;
+    }
+
+    if (event->type == PropertyNotify &&
+        event->xproperty.atom == _glfw.x11.GLFW_CLIPBOARD_REQUEST)
+    {
+        if (!_glfw.x11.clipboardRequest.incr ||
+            event->xproperty.state != PropertyNewValue)
+        {
+            return GLFW_TRUE;
+        }
+
+        XGetWindowProperty(_glfw.x11.display,
+                           _glfw.x11.clipboardRequest.window,
+                           _glfw.x11.GLFW_CLIPBOARD_REQUEST,
+                           0,
+                           LONG_MAX,
+                           True,
+                           AnyPropertyType,
+                           &actualType,
+                           &actualFormat,
+                           &itemCount,
+                           &bytesAfter,
+                           (unsigned char**) &data);
+
+        if (itemCount)
+        {
+            // Deleting the property above asked the owner for the next chunk
+            if (appendClipboardData(data, itemCount))
+                extendClipboardRequest();
+            else
+                endClipboardRequest(GLFW_FALSE);
+        }
+        else
+        {
+            // A zero-length chunk marks the end of the transfer
+            endClipboardRequest(_glfw.x11.clipboardRequest.string != NULL);
+        }
+
+        if (data)
+            XFree(data);
+
+        return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
 // Make the specified window and its video mode active on its monitor
 //
 static void acquireMonitor(_GLFWwindow* window)
@@ -1149,11 +1607,24 @@ static void processEvent(XEvent *event)
     int keycode = 0;
     Bool filtered = False;
 
+    _GLFWwindow* window = NULL;
+    if (XFindContext(_glfw.x11.display,
+                     event->xany.window,
+                     _glfw.x11.context,
+                     (XPointer*) &window) != 0)
+    {
+        window = NULL;
+    }
+
     // HACK: Save scancode as some IMs clear the field in XFilterEvent
     if (event->type == KeyPress || event->type == KeyRelease)
         keycode = event->xkey.keycode;
 
-    filtered = XFilterEvent(event, None);
+    // NOTE: Events for our windows only need to pass through the IM if the
+    //       window has an input context, but events for other windows may be
+    //       IM protocol traffic and must always be filtered
+    if (_glfw.x11.im && (!window || window->x11.ic))
+        filtered = XFilterEvent(event, None);
 
     if (_glfw.x11.randr.available)
     {
@@ -1183,7 +1654,7 @@ static void processEvent(XEvent *event)
     {
         if (_glfw.x11.xi.available)
         {
-            _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
+            window = _glfw.x11.disabledCursorWindow;
 
             if (window &&
                 window->rawMouseMotion &&
@@ -1223,11 +1694,23 @@ static void processEvent(XEvent *event)
         return;
     }
 
-    _GLFWwindow* window = NULL;
-    if (XFindContext(_glfw.x11.display,
-                     event->xany.window,
-                     _glfw.x11.context,
-                     (XPointer*) &window) != 0)
+    if (event->type == PropertyNotify &&
+        event->xproperty.window == _glfw.x11.root)
+    {
+        _glfwUpdateWorkareaX11(event->xproperty.atom);
+        return;
+    }
+
+    if (!window && handleIncrEvent(event))
+        return;
+
+    if (event->xany.window == _glfw.x11.clipboardRequest.window &&
+        handleClipboardRequestEvent(event))
+    {
+        return;
+    }
+
+    if (!window)
     {
         // This is an event for a window that has already been destroyed
         return;
@@ -1898,6 +2381,11 @@ void _glfwPushSelectionToManagerX11(void)
                     handleSelectionRequest(&event);
                     break;
 
+                case PropertyNotify:
+                case DestroyNotify:
+                    handleIncrEvent(&event);
+                    break;
+
                 case SelectionNotify:
                 {
                     if (event.xselection.target == _glfw.x11.SAVE_TARGETS)
@@ -1938,15 +2426,11 @@ void _glfwCreateInputContextX11(_GLFWwindow* window)
 
     if (window->x11.ic)
     {
-        XWindowAttributes attribs;
-        XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
-
         unsigned long filter = 0;
         if (XGetICValues(window->x11.ic, XNFilterEvents, &filter, NULL) == NULL)
         {
-            XSelectInput(_glfw.x11.display,
-                         window->x11.handle,
-                         attribs.your_event_mask | filter);
+            window->x11.filterEvents = filter;
+            updateEventMask(window);
         }
     }
 }
@@ -2614,6 +3098,11 @@ GLFWbool _glfwFramebufferTransparentX11(_GLFWwindow* window)
     return XGetSelectionOwner(_glfw.x11.display, _glfw.x11.NET_WM_CM_Sx) != None;
 }
 
+GLFWbool _glfwWindowAsyncPresentationX11(_GLFWwindow* window)
+{
+    return GLFW_FALSE;
+}
+
 void _glfwSetWindowResizableX11(_GLFWwindow* window, GLFWbool enabled)
 {
     int width, height;
@@ -2729,6 +3218,33 @@ void _glfwSetWindowMousePassthroughX11(_GLFWwindow* window, GLFWbool enabled)
     }
 }
 
+void _glfwSetWindowAsyncPresentationX11(_GLFWwindow* window, GLFWbool enabled)
+{
+}
+
+void _glfwUpdateWindowEventsX11(_GLFWwindow* window)
+{
+    // NOTE: The input context is created on demand, as creating it costs
+    //       several round-trips and every event for a window with an input
+    //       context has to be passed through the input method
+    if (_glfw.x11.im && !window->x11.ic &&
+        (window->callbacks.character || window->callbacks.charmods))
+    {
+        _glfwCreateInputContextX11(window);
+
+        if (window->x11.ic && _glfwWindowFocusedX11(window))
+            XSetICFocus(window->x11.ic);
+    }
+
+    updateEventMask(window);
+    XFlush(_glfw.x11.display);
+}
+
+GLFWbool _glfwWindowReadyForFrameX11(_GLFWwindow* window)
+{
+    return GLFW_TRUE;
+}
+
 float _glfwGetWindowOpacityX11(_GLFWwindow* window)
 {
     float opacity = 1.f;
@@ -2785,7 +3301,10 @@ void _glfwPollEventsX11(void)
 
 #if defined(GLFW_BUILD_LINUX_JOYSTICK)
     if (_glfw.joysticksInitialized)
+    {
         _glfwDetectJoystickConnectionLinux();
+        _glfwPollJoysticksLinux();
+    }
 #endif
     XPending(_glfw.x11.display);
 
@@ -2796,6 +3315,18 @@ void _glfwPollEventsX11(void)
         processEvent(&event);
     }
 
+    if (_glfw.x11.incr.count)
+        expireIncrTransfers();
+
+    if (_glfw.x11.clipboardRequest.target &&
+        getClipboardRequestTimeout() == 0.0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "X11: Timed out waiting for clipboard data");
+        _glfw_free(_glfw.x11.clipboardRequest.string);
+        finishClipboardRequest(NULL);
+    }
+
     _GLFWwindow* window = _glfw.x11.disabledCursorWindow;
     if (window)
     {
@@ -2816,12 +3347,28 @@ void _glfwPollEventsX11(void)
 
 void _glfwWaitEventsX11(void)
 {
-    waitForAnyEvent(NULL);
+    if (_glfw.x11.clipboardRequest.target)
+    {
+        // Wake up in time to abandon an unresponsive clipboard owner
+        double timeout = getClipboardRequestTimeout();
+        waitForAnyEvent(&timeout);
+    }
+    else
+        waitForAnyEvent(NULL);
+
     _glfwPollEventsX11();
 }
 
 void _glfwWaitEventsTimeoutX11(double timeout)
 {
+    if (_glfw.x11.clipboardRequest.target)
+    {
+        // Wake up in time to abandon an unresponsive clipboard owner
+        const double remaining = getClipboardRequestTimeout();
+        if (remaining < timeout)
+            timeout = remaining;
+    }
+
     waitForAnyEvent(&timeout);
     _glfwPollEventsX11();
 }
@@ -2861,6 +3408,8 @@ void _glfwSetCursorPosX11(_GLFWwindow* window, double x, double y)
 
 void _glfwSetCursorModeX11(_GLFWwindow* window, int mode)
 {
+    updateEventMask(window);
+
     if (_glfwWindowFocusedX11(window))
     {
         if (mode == GLFW_CURSOR_DISABLED)
@@ -3082,6 +3631,18 @@ const char* _glfwGetClipboardStringX11(void)
     return getSelectionString(_glfw.x11.CLIPBOARD);
 }
 
+void _glfwRequestClipboardStringX11(void)
+{
+    if (XGetSelectionOwner(_glfw.x11.display, _glfw.x11.CLIPBOARD) ==
+        _glfw.x11.helperWindowHandle)
+    {
+        _glfwInputClipboardString(_glfw.x11.clipboardString);
+        return;
+    }
+
+    requestClipboardTarget(_glfw.x11.UTF8_STRING);
+}
+
 EGLenum _glfwGetEGLPlatformX11(EGLint** attribs)
 {
     if (_glfw.egl.ANGLE_platform_angle)
@@ -53,6 +53,14 @@ static void error_callback(int error, const char* description)
     fprintf(stderr, "Error: %s\n", description);
 }
 
+static void clipboard_callback(const char* string)
+{
+    if (string)
+        printf("Clipboard request returned \"%s\"\n", string);
+    else
+        printf("Clipboard request did not return a string\n");
+}
+
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     if (action != GLFW_PRESS)
@@ -75,6 +83,11 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
                 else
                     printf("Clipboard does not contain a string\n");
             }
+            else if (mods == (MODIFIER | GLFW_MOD_SHIFT))
+            {
+                printf("Requesting clipboard contents\n");
+                glfwRequestClipboardString(clipboard_callback);
+            }
             break;
 
         case GLFW_KEY_C:
@@ -532,6 +532,19 @@ static void joystick_callback(int jid, int event)
     }
 }
 
+static void joystick_axis_callback(int jid, int axis, float value)
+{
+    printf("%08x at %0.3f: Joystick %i axis %i moved to %0.3f\n",
+           counter++, glfwGetTime(), jid, axis, value);
+}
+
+static void joystick_button_callback(int jid, int button, int action)
+{
+    printf("%08x at %0.3f: Joystick %i button %i was %s\n",
+           counter++, glfwGetTime(), jid, button,
+           get_action_name(action));
+}
+
 int main(int argc, char** argv)
 {
     Slot* slots;
@@ -547,6 +560,8 @@ int main(int argc, char** argv)
 
     glfwSetMonitorCallback(monitor_callback);
     glfwSetJoystickCallback(joystick_callback);
+    glfwSetJoystickAxisCallback(joystick_axis_callback);
+    glfwSetJoystickButtonCallback(joystick_button_callback);
 
     while ((ch = getopt(argc, argv, "hfn:")) != -1)
     {
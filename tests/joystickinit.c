@@ -0,0 +1,142 @@
+//========================================================================
+// Joystick first-call latency test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test initializes and terminates GLFW repeatedly and times the first
+// joystick call after each initialization, which is where the joystick
+// devices are enumerated and opened
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: joystickinit [-h] [-n] [-t] [-i ITERATIONS]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -i run the specified number of iterations (default 10)\n");
+    printf("  -n use the Null platform\n");
+    printf("  -t read joystick input on a separate thread\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, iterations = 10;
+    int platform = GLFW_ANY_PLATFORM;
+    int thread = GLFW_FALSE;
+
+    while ((ch = getopt(argc, argv, "hi:nt")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'i':
+                iterations = atoi(optarg);
+                break;
+
+            case 'n':
+                platform = GLFW_PLATFORM_NULL;
+                break;
+
+            case 't':
+                thread = GLFW_TRUE;
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (iterations < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    double first_min = 0.0, first_max = 0.0, first_total = 0.0;
+    double second_total = 0.0;
+
+    for (int i = 0;  i < iterations;  i++)
+    {
+        glfwInitHint(GLFW_PLATFORM, platform);
+        glfwInitHint(GLFW_JOYSTICK_THREAD, thread);
+
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        const uint64_t start = glfwGetTimerValue();
+        glfwJoystickPresent(GLFW_JOYSTICK_1);
+        const uint64_t middle = glfwGetTimerValue();
+        glfwJoystickPresent(GLFW_JOYSTICK_1);
+        const uint64_t end = glfwGetTimerValue();
+        const double frequency = (double) glfwGetTimerFrequency();
+
+        int count = 0;
+        for (int jid = GLFW_JOYSTICK_1;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+        {
+            if (glfwJoystickPresent(jid))
+                count++;
+        }
+
+        glfwTerminate();
+
+        const double first = (middle - start) * 1e6 / frequency;
+        const double second = (end - middle) * 1e6 / frequency;
+
+        printf("%3i: first call %10.1f us, second call %8.1f us, %i joysticks\n",
+               i, first, second, count);
+
+        if (i == 0 || first < first_min)
+            first_min = first;
+        if (i == 0 || first > first_max)
+            first_max = first;
+
+        first_total += first;
+        second_total += second;
+    }
+
+    printf("First call: min %.1f us, avg %.1f us, max %.1f us\n",
+           first_min, first_total / iterations, first_max);
+    printf("Second call: avg %.1f us\n", second_total / iterations);
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,186 @@
+//========================================================================
+// Gamepad mapping parsing benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test times glfwUpdateGamepadMappingsFromFile on the Null platform,
+// first with the built-in mappings for all platforms and then with each
+// gamecontrollerdb.txt style file specified on the command line
+//
+// The built-in mappings are written to a temporary file in the current
+// directory so that both are parsed the same way
+//
+//========================================================================
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+// Include the built-in mappings for every platform under a name that does not
+// collide with the library copy
+#define _GLFW_WIN32
+#define _GLFW_COCOA
+#define GLFW_BUILD_LINUX_JOYSTICK
+#define _glfwDefaultMappings default_mappings
+#include "mappings.h"
+
+#define BUILTIN_PATH "mappingparse.tmp"
+
+static void usage(void)
+{
+    printf("Usage: mappingparse [-h] [-i ITERATIONS] [FILE ...]\n");
+    printf("Options:\n");
+    printf("  -h show this help\n");
+    printf("  -i run the specified number of iterations (default 10)\n");
+}
+
+// Invalid mappings are reported as errors, so they are counted rather than
+// printed to keep output from affecting the timing
+static int error_count = 0;
+static char last_error[1024];
+
+static void error_callback(int error, const char* description)
+{
+    error_count++;
+    snprintf(last_error, sizeof(last_error), "%s", description);
+}
+
+static int write_builtin_mappings(const char* path)
+{
+    const size_t count = sizeof(default_mappings) / sizeof(char*);
+
+    FILE* file = fopen(path, "wb");
+    if (!file)
+    {
+        fprintf(stderr, "Failed to create %s\n", path);
+        return GLFW_FALSE;
+    }
+
+    for (size_t i = 0;  i < count;  i++)
+        fprintf(file, "%s\n", default_mappings[i]);
+
+    fclose(file);
+    return GLFW_TRUE;
+}
+
+static int benchmark(const char* name, const char* path, int iterations)
+{
+    double best = 0.0, total = 0.0;
+    int accepted = 0, skipped = 0, too_long = 0;
+
+    for (int i = 0;  i < iterations;  i++)
+    {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
+        if (!glfwInit())
+        {
+            fprintf(stderr, "Error: %s\n", last_error);
+            return GLFW_FALSE;
+        }
+
+        error_count = 0;
+
+        const uint64_t start = glfwGetTimerValue();
+        const int result = glfwUpdateGamepadMappingsFromFile(path,
+                                                             &accepted,
+                                                             &skipped,
+                                                             &too_long);
+        const uint64_t end = glfwGetTimerValue();
+        const double frequency = (double) glfwGetTimerFrequency();
+
+        glfwTerminate();
+
+        if (!result)
+        {
+            fprintf(stderr, "Error: %s\n", last_error);
+            return GLFW_FALSE;
+        }
+
+        const double elapsed = (end - start) * 1e3 / frequency;
+        if (i == 0 || elapsed < best)
+            best = elapsed;
+
+        total += elapsed;
+    }
+
+    const int lines = accepted + skipped + too_long;
+
+    printf("%s: %i accepted, %i skipped, %i too long, %i errors\n",
+           name, accepted, skipped, too_long, error_count);
+    printf("  best %.3f ms, avg %.3f ms, %.0f ns per line\n",
+           best, total / iterations, lines ? best * 1e6 / lines : 0.0);
+
+    return GLFW_TRUE;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, iterations = 10;
+
+    while ((ch = getopt(argc, argv, "hi:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'i':
+                iterations = atoi(optarg);
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    if (iterations < 1)
+    {
+        usage();
+        exit(EXIT_FAILURE);
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!write_builtin_mappings(BUILTIN_PATH))
+        exit(EXIT_FAILURE);
+
+    const int result = benchmark("mappings.h", BUILTIN_PATH, iterations);
+    remove(BUILTIN_PATH);
+
+    if (!result)
+        exit(EXIT_FAILURE);
+
+    for (int i = optind;  i < argc;  i++)
+    {
+        if (!benchmark(argv[i], argv[i], iterations))
+            exit(EXIT_FAILURE);
+    }
+
+    exit(EXIT_SUCCESS);
+}